@@ -0,0 +1,51 @@
+// Benchmark: avapi::parseCsvFile() (memory mapped) against reading the file
+// into an std::string first, on a generated intraday csv archive.
+//
+// usage: bench01_parseCsvFile [file] [megabytes]
+//        (default = "bench_intraday.csv", 1024)
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include "avapi/CsvTokenizer.hpp"
+#include "avapi/misc.hpp"
+#include "generate.hpp"
+
+/// @brief The pre-mmap parseCsvFile(): stage the file in an std::string
+avapi::TimeSeries parseBuffered(const std::string &path)
+{
+    std::ifstream file(path, std::ios::binary);
+    file.seekg(0, std::ios::end);
+    std::string data(static_cast<size_t>(file.tellg()), '\0');
+    file.seekg(0);
+    file.read(&data[0], data.size());
+    return avapi::CsvTokenizer().parse(data);
+}
+
+int main(int argc, char *argv[])
+{
+    std::string path = argc > 1 ? argv[1] : "bench_intraday.csv";
+    size_t megabytes = argc > 2 ? std::stoul(argv[2]) : 1024;
+
+    if (!std::filesystem::exists(path)) {
+        std::cout << "Generating " << megabytes << " MB in " << path << "\n";
+        generate(path, megabytes);
+    }
+    double mb = std::filesystem::file_size(path) / (1024.0 * 1024.0);
+
+    // Warm the page cache so both runs measure parsing, not the disk
+    parseBuffered(path);
+
+    size_t rows = 0;
+    double buffered = seconds([&]() { rows = parseBuffered(path).rowCount(); });
+    double mapped = seconds(
+        [&]() { rows = avapi::parseCsvFile(path).rowCount(); });
+
+    std::cout << rows << " rows, " << mb << " MB\n"
+              << "ifstream + std::string: " << buffered << " s, "
+              << mb / buffered << " MB/s\n"
+              << "mmap:                   " << mapped << " s, " << mb / mapped
+              << " MB/s\n";
+    return 0;
+}
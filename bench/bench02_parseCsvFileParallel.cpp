@@ -0,0 +1,43 @@
+// Benchmark: avapi::parseCsvFileParallel() with a growing number of chunks
+// against avapi::parseCsvFile(), on a generated intraday csv archive.
+//
+// usage: bench02_parseCsvFileParallel [file] [megabytes]
+//        (default = "bench_intraday.csv", 1024)
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <thread>
+#include "avapi/misc.hpp"
+#include "avapi/ThreadPool.hpp"
+#include "generate.hpp"
+
+int main(int argc, char *argv[])
+{
+    std::string path = argc > 1 ? argv[1] : "bench_intraday.csv";
+    size_t megabytes = argc > 2 ? std::stoul(argv[2]) : 1024;
+
+    if (!std::filesystem::exists(path)) {
+        std::cout << "Generating " << megabytes << " MB in " << path << "\n";
+        generate(path, megabytes);
+    }
+    double mb = std::filesystem::file_size(path) / (1024.0 * 1024.0);
+
+    // Warm the page cache so every run measures parsing, not the disk
+    size_t rows = avapi::parseCsvFile(path).rowCount();
+    double serial = seconds([&]() { avapi::parseCsvFile(path); });
+
+    std::cout << rows << " rows, " << mb << " MB, "
+              << avapi::ThreadPool::cpu().size() << " cpu() threads\n"
+              << "parseCsvFile:                  " << serial << " s, "
+              << mb / serial << " MB/s\n";
+
+    size_t cores = avapi::ThreadPool::cpu().size();
+    for (size_t threads = 1; threads <= cores; threads *= 2) {
+        double parallel = seconds(
+            [&]() { avapi::parseCsvFileParallel(path, false, threads); });
+        std::cout << "parseCsvFileParallel (" << threads
+                  << " chunks): " << parallel << " s, " << mb / parallel
+                  << " MB/s, x" << serial / parallel << "\n";
+    }
+    return 0;
+}
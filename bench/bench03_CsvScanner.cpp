@@ -0,0 +1,85 @@
+// Benchmark: avapi::CsvScanner at every supported instruction set, alone and
+// inside avapi::CsvTokenizer, on btc.csv shaped rows held in memory.
+//
+// usage: bench03_CsvScanner [megabytes]
+//        (default = 256)
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include "avapi/CsvScanner.hpp"
+#include "avapi/CsvTokenizer.hpp"
+#include "generate.hpp"
+
+/// @brief Build a DIGITAL_CURRENCY_DAILY csv body of roughly the given size
+std::string generateCrypto(const size_t &megabytes)
+{
+    std::string data = "timestamp,open (CNY),high (CNY),low (CNY),close (CNY),"
+                       "open (USD),high (USD),low (USD),close (USD),volume,"
+                       "market cap (USD)\n";
+    const size_t target = megabytes * 1024 * 1024;
+    data.reserve(target + 256);
+
+    char line[256];
+    for (long day = 0; data.size() < target; ++day) {
+        double usd = 30000.0 + day % 20000;
+        double volume = 7000.0 + day % 90000 / 7.0;
+        int n = std::snprintf(
+            line, sizeof(line),
+            "%04ld-%02ld-%02ld,%.8f,%.8f,%.8f,%.8f,%.8f,%.8f,%.8f,%.8f,%.8f,"
+            "%.8f\n",
+            2021 - day / 336 % 40, 12 - day / 28 % 12, 28 - day % 28,
+            usd * 6.47, usd * 6.5, usd * 6.2, usd * 6.3, usd, usd * 1.004,
+            usd * 0.96, usd * 0.97, volume, volume);
+        data.append(line, n);
+    }
+    return data;
+}
+
+/// @brief Name of an instruction set
+const char *name(const avapi::SimdLevel &level)
+{
+    switch (level) {
+    case avapi::SimdLevel::AVX2:
+        return "AVX2  ";
+    case avapi::SimdLevel::SSE2:
+        return "SSE2  ";
+    default:
+        return "scalar";
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    size_t megabytes = argc > 1 ? std::stoul(argv[1]) : 256;
+    std::string data = generateCrypto(megabytes);
+    double mb = data.size() / (1024.0 * 1024.0);
+    std::cout << mb << " MB of btc.csv shaped rows\n";
+
+    for (auto level : {avapi::SimdLevel::SCALAR, avapi::SimdLevel::SSE2,
+                       avapi::SimdLevel::AVX2}) {
+        if (!avapi::CsvScanner::supported(level))
+            continue;
+
+        // Same 64 KB blocks as the tokenizer
+        avapi::CsvScanner scanner(level);
+        size_t separators = 0;
+        double scan = seconds([&]() {
+            for (size_t i = 0; i < data.size(); i += 64 * 1024) {
+                separators += scanner.scan(
+                    std::string_view(data).substr(i, 64 * 1024));
+            }
+        });
+
+        avapi::CsvTokenizer tokenizer(true);
+        tokenizer.setSimdLevel(level);
+        size_t rows = 0;
+        double parse =
+            seconds([&]() { rows = tokenizer.parse(data).rowCount(); });
+
+        std::cout << name(level) << " scan:  " << mb / scan << " MB/s ("
+                  << separators << " separators)\n"
+                  << name(level) << " parse: " << mb / parse << " MB/s ("
+                  << rows << " rows)\n";
+    }
+    return 0;
+}
@@ -0,0 +1,184 @@
+// Benchmark: the single pass SAX parsers of avapi/JsonSax.hpp against the
+// nlohmann::json DOM code they replaced, on a generated earnings history and
+// on OVERVIEW, CRYPTO_RATING and CURRENCY_EXCHANGE_RATE bodies.
+//
+// usage: bench04_JsonSax [reports] [repeats]
+//        (default = 200000, 2000)
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <nlohmann/json.hpp>
+#include "avapi/JsonSax.hpp"
+#include "avapi/misc.hpp"
+#include "generate.hpp"
+
+/// @brief An EARNINGS body with the given number of quarterly reports
+std::string generateEarnings(const size_t &reports)
+{
+    std::string data = "{\"symbol\": \"TSLA\", \"annualEarnings\": [";
+    for (size_t i = 0; i < reports / 4; ++i) {
+        data += i == 0 ? "" : ",";
+        data += "{\"fiscalDateEnding\": \"" + std::to_string(2020 - i % 50) +
+                "-12-31\", \"reportedEPS\": \"" + std::to_string(i % 7) +
+                ".22\"}";
+    }
+    data += "], \"quarterlyEarnings\": [";
+    for (size_t i = 0; i < reports; ++i) {
+        data += i == 0 ? "" : ",";
+        data += "{\"fiscalDateEnding\": \"2020-12-31\", \"reportedDate\": "
+                "\"2021-01-27\", \"reportedEPS\": \"0.8\", \"estimatedEPS\": "
+                "\"1.03\", \"surprise\": \"-0.23\", "
+                "\"surprisePercentage\": \"" +
+                std::to_string(i) + "\"}";
+    }
+    return data + "]}";
+}
+
+/// @brief An OVERVIEW sized body
+std::string generateOverview()
+{
+    std::string data = "{\"Symbol\": \"TSLA\"";
+    for (int i = 0; i < 58; ++i) {
+        data += ", \"Field" + std::to_string(i) + "\": \"" +
+                std::to_string(i * 1048.83) + "\"";
+    }
+    return data + "}";
+}
+
+/// @brief The pre-SAX CompanyEarnings::update(), parsing the body twice
+void domEarnings(const std::string &data, avapi::AnnualEarnings &annual,
+                 avapi::QuarterlyEarnings &quarterly)
+{
+    nlohmann::json years = nlohmann::json::parse(data)["annualEarnings"];
+    annual.data.clear();
+    for (auto &field : years) {
+        annual.data.push_back(
+            {field["fiscalDateEnding"], field["reportedEPS"]});
+    }
+
+    nlohmann::json quarters = nlohmann::json::parse(data)["quarterlyEarnings"];
+    quarterly.data.clear();
+    for (auto &field : quarters) {
+        quarterly.data.push_back(
+            {field["fiscalDateEnding"], field["reportedDate"],
+             field["reportedEPS"], field["estimatedEPS"], field["surprise"],
+             field["surprisePercentage"]});
+    }
+}
+
+/// @brief The pre-SAX CompanyOverview::update()
+void domOverview(const std::string &data,
+                 std::unordered_map<std::string, std::string> &fields)
+{
+    nlohmann::json json_data = nlohmann::json::parse(data);
+    fields.clear();
+    auto obj = json_data.get<nlohmann::json::object_t>();
+    for (auto &kvp : obj)
+        fields.insert({kvp.first, kvp.second.get<std::string>()});
+}
+
+/// @brief The pre-SAX HealthIndex::update()
+void domHealthIndex(const std::string &data, std::vector<std::string> &fields,
+                    std::time_t &timestamp)
+{
+    nlohmann::json json = nlohmann::json::parse(data)["Crypto Rating (FCAS)"];
+    fields.clear();
+    for (const char *key : {"1. symbol", "2. name", "3. fcas rating",
+                            "4. fcas score", "5. developer score",
+                            "6. market maturity score", "7. utility score",
+                            "9. timezone"})
+        fields.push_back(json[key]);
+    timestamp = avapi::toUnixTimestamp(
+        json["8. last refreshed"].get<std::string>(), avapi::TimeZone::UTC);
+}
+
+/// @brief The pre-SAX CryptoPricing::exchange()
+avapi::ExchangeRate domExchangeRate(const std::string &data)
+{
+    nlohmann::json json =
+        nlohmann::json::parse(data)["Realtime Currency Exchange Rate"];
+    std::time_t timestamp = avapi::toUnixTimestamp(
+        json["6. Last Refreshed"].get<std::string>(), avapi::TimeZone::UTC);
+    std::vector<double> rates = {
+        std::stod(std::string(json["5. Exchange Rate"])),
+        std::stod(std::string(json["8. Bid Price"])),
+        std::stod(std::string(json["9. Ask Price"]))};
+    return {"BTC", "USD", timestamp, rates};
+}
+
+/// @brief Print one DOM / SAX comparison
+void report(const char *name, const double &dom, const double &sax,
+            const double &mb)
+{
+    std::cout << name << " DOM: " << mb / dom << " MB/s, SAX: " << mb / sax
+              << " MB/s, x" << dom / sax << "\n";
+}
+
+int main(int argc, char *argv[])
+{
+    size_t reports = argc > 1 ? std::stoul(argv[1]) : 200000;
+    size_t repeats = argc > 2 ? std::stoul(argv[2]) : 2000;
+
+    std::string earnings = generateEarnings(reports);
+    double mb = earnings.size() / (1024.0 * 1024.0);
+    std::cout << reports << " quarterly reports, " << mb << " MB\n";
+
+    avapi::AnnualEarnings annual;
+    avapi::QuarterlyEarnings quarterly;
+    double dom = seconds([&]() { domEarnings(earnings, annual, quarterly); });
+    double sax = seconds(
+        [&]() { avapi::parseEarnings(earnings, annual, quarterly); });
+    report("EARNINGS:              ", dom, sax, mb);
+
+    // The small bodies are parsed repeatedly
+    std::string overview = generateOverview();
+    std::unordered_map<std::string, std::string> fields;
+    mb = overview.size() * repeats / (1024.0 * 1024.0);
+    dom = seconds([&]() {
+        for (size_t i = 0; i < repeats; ++i)
+            domOverview(overview, fields);
+    });
+    sax = seconds([&]() {
+        for (size_t i = 0; i < repeats; ++i)
+            avapi::parseOverview(overview, fields);
+    });
+    report("OVERVIEW:              ", dom, sax, mb);
+
+    std::string rating =
+        "{\"Crypto Rating (FCAS)\": {\"1. symbol\": \"BTC\", \"2. name\": "
+        "\"Bitcoin\", \"3. fcas rating\": \"Superb\", \"4. fcas score\": "
+        "\"910\", \"5. developer score\": \"856\", \"6. market maturity "
+        "score\": \"888\", \"7. utility score\": \"974\", \"8. last "
+        "refreshed\": \"2021-03-05 00:00:00\", \"9. timezone\": \"UTC\"}}";
+    std::vector<std::string> values;
+    std::time_t timestamp;
+    mb = rating.size() * repeats / (1024.0 * 1024.0);
+    dom = seconds([&]() {
+        for (size_t i = 0; i < repeats; ++i)
+            domHealthIndex(rating, values, timestamp);
+    });
+    sax = seconds([&]() {
+        for (size_t i = 0; i < repeats; ++i)
+            avapi::parseHealthIndex(rating, values, timestamp);
+    });
+    report("CRYPTO_RATING:         ", dom, sax, mb);
+
+    std::string exchange =
+        "{\"Realtime Currency Exchange Rate\": {\"1. From_Currency Code\": "
+        "\"BTC\", \"2. From_Currency Name\": \"Bitcoin\", \"3. To_Currency "
+        "Code\": \"USD\", \"4. To_Currency Name\": \"United States Dollar\", "
+        "\"5. Exchange Rate\": \"48374.09\", \"6. Last Refreshed\": "
+        "\"2021-03-05 12:00:00\", \"7. Time Zone\": \"UTC\", \"8. Bid "
+        "Price\": \"48374.08\", \"9. Ask Price\": \"48374.10\"}}";
+    mb = exchange.size() * repeats / (1024.0 * 1024.0);
+    dom = seconds([&]() {
+        for (size_t i = 0; i < repeats; ++i)
+            domExchangeRate(exchange);
+    });
+    sax = seconds([&]() {
+        for (size_t i = 0; i < repeats; ++i)
+            avapi::parseExchangeRate(exchange, "BTC", "USD");
+    });
+    report("CURRENCY_EXCHANGE_RATE:", dom, sax, mb);
+    return 0;
+}
@@ -0,0 +1,51 @@
+// Benchmark: parsing a generated intraday csv archive into integer ticks
+// (avapi::parseCsvFileFixed()) against doubles (avapi::parseCsvFile()), then
+// summing the close column of each.
+//
+// usage: bench05_FixedTimeSeries [file] [megabytes]
+//        (default = "bench_intraday.csv", 256)
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include "avapi/misc.hpp"
+#include "generate.hpp"
+
+int main(int argc, char *argv[])
+{
+    std::string path = argc > 1 ? argv[1] : "bench_intraday.csv";
+    size_t megabytes = argc > 2 ? std::stoul(argv[2]) : 256;
+
+    if (!std::filesystem::exists(path)) {
+        std::cout << "Generating " << megabytes << " MB in " << path << "\n";
+        generate(path, megabytes);
+    }
+    double mb = std::filesystem::file_size(path) / (1024.0 * 1024.0);
+
+    // Warm the page cache so both runs measure parsing, not the disk
+    avapi::parseCsvFile(path);
+
+    // Both results are moved into place, no row is copied
+    avapi::TimeSeries series;
+    avapi::FixedTimeSeries fixed;
+    double parse_double =
+        seconds([&]() { series = avapi::parseCsvFile(path); });
+    double parse_fixed =
+        seconds([&]() { fixed = avapi::parseCsvFileFixed(path); });
+
+    double sum_double = 0;
+    int64_t sum_fixed = 0;
+    double add_double = seconds([&]() {
+        for (size_t i = 0; i < series.rowCount(); ++i)
+            sum_double += series[i][3];
+    });
+    double add_fixed = seconds([&]() { sum_fixed = fixed.sum(3); });
+
+    std::cout << series.rowCount() << " rows, " << mb << " MB\n"
+              << "parse double: " << mb / parse_double << " MB/s\n"
+              << "parse ticks:  " << mb / parse_fixed << " MB/s\n"
+              << "sum double:   " << add_double * 1000 << " ms, "
+              << std::fixed << sum_double << "\n"
+              << "sum ticks:    " << add_fixed * 1000 << " ms, "
+              << fixed.toString(sum_fixed) << "\n";
+    return 0;
+}
@@ -0,0 +1,66 @@
+// Benchmark: aggregating the close column of weekly_AAPL.csv stored row-wise
+// (one std::vector<double> per avapi::TimePair, the pre-columnar layout)
+// against the columnar avapi::TimeSeries, including the time to build each.
+//
+// usage: bench06_ColumnarTimeSeries [file] [repeats]
+//        (default = "test/data/weekly_AAPL.csv", 2000)
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "avapi/CsvRowReader.hpp"
+#include "avapi/misc.hpp"
+#include "generate.hpp"
+
+int main(int argc, char *argv[])
+{
+    std::string path = argc > 1 ? argv[1] : "test/data/weekly_AAPL.csv";
+    size_t repeats = argc > 2 ? std::stoul(argv[2]) : 2000;
+    double mb = std::filesystem::file_size(path) * repeats / (1024.0 * 1024.0);
+
+    // The rows as they were kept before, each owning its data
+    std::vector<avapi::TimePair> rows;
+    double build_rows = seconds([&]() {
+        for (size_t i = 0; i < repeats; ++i) {
+            rows.clear();
+            avapi::CsvRowReader reader(path);
+            avapi::TimePair row;
+            while (reader.next(row))
+                rows.push_back(row);
+        }
+    });
+
+    avapi::TimeSeries series;
+    double build_columns = seconds([&]() {
+        for (size_t i = 0; i < repeats; ++i)
+            series = avapi::parseCsvFile(path);
+    });
+
+    // Mean close, 100 times as many passes as parses
+    double row_sum = 0;
+    double scan_rows = seconds([&]() {
+        for (size_t i = 0; i < repeats * 100; ++i) {
+            for (auto &row : rows)
+                row_sum += row.data[3];
+        }
+    });
+
+    double column_sum = 0;
+    avapi::Span<double> closes = series.close();
+    double scan_columns = seconds([&]() {
+        for (size_t i = 0; i < repeats * 100; ++i) {
+            for (double close : closes)
+                column_sum += close;
+        }
+    });
+
+    double passes = repeats * 100.0 * series.rowCount();
+    std::cout << series.rowCount() << " rows, " << repeats << " repeats\n"
+              << "build row-wise: " << mb / build_rows << " MB/s\n"
+              << "build columnar: " << mb / build_columns << " MB/s\n"
+              << "scan row-wise:  " << scan_rows * 1e9 / passes
+              << " ns/row (" << row_sum / passes << ")\n"
+              << "scan columnar:  " << scan_columns * 1e9 / passes
+              << " ns/row (" << column_sum / passes << ")\n";
+    return 0;
+}
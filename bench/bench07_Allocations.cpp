@@ -0,0 +1,207 @@
+// Benchmark: heap allocations made while building, parsing and handing over
+// an avapi::TimeSeries, counted by replacing every global operator new.
+//
+// usage: bench07_Allocations [rows] [file]
+//        (default = 1000000, "test/data/weekly_AAPL.csv")
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+#include "avapi/misc.hpp"
+#include "generate.hpp"
+
+static std::atomic<size_t> allocations{0};
+
+// Inlined into the caller, GCC pairs std::free with the operator new the
+// pointer came from and warns with -Wmismatched-new-delete
+#ifdef _MSC_VER
+#define BENCH_NOINLINE __declspec(noinline)
+#else
+#define BENCH_NOINLINE __attribute__((noinline))
+#endif
+
+/// @brief Count one allocation and take it from malloc, nullptr on failure
+static void *allocate(size_t size) noexcept
+{
+    ++allocations;
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+/// @brief Count one over-aligned allocation, e.g. every column of a
+/// std::pmr::new_delete_resource(). The malloc'ed block is kept just below
+/// the aligned address.
+static void *allocate(size_t size, std::align_val_t align) noexcept
+{
+    size_t alignment = static_cast<size_t>(align);
+    void *block = allocate(size + alignment + sizeof(void *));
+    if (block == nullptr)
+        return nullptr;
+    uintptr_t first = reinterpret_cast<uintptr_t>(block) + sizeof(void *);
+    void *memory = reinterpret_cast<void *>((first + alignment - 1) &
+                                            ~(alignment - 1));
+    static_cast<void **>(memory)[-1] = block;
+    return memory;
+}
+
+/// @brief Free a block from allocate(size, align)
+BENCH_NOINLINE static void deallocate(void *memory, std::align_val_t) noexcept
+{
+    if (memory != nullptr)
+        std::free(static_cast<void **>(memory)[-1]);
+}
+
+/// @brief Free a block from allocate(size)
+BENCH_NOINLINE static void deallocate(void *memory) noexcept
+{
+    std::free(memory);
+}
+
+/// @brief Throw where a throwing operator new runs out of memory
+static void *checked(void *memory)
+{
+    if (memory == nullptr)
+        throw std::bad_alloc();
+    return memory;
+}
+
+// Every form that allocates is counted, and every delete frees the way its
+// operator new allocated
+void *operator new(size_t size) { return checked(allocate(size)); }
+void *operator new[](size_t size) { return checked(allocate(size)); }
+void *operator new(size_t size, const std::nothrow_t &) noexcept
+{
+    return allocate(size);
+}
+void *operator new[](size_t size, const std::nothrow_t &) noexcept
+{
+    return allocate(size);
+}
+void *operator new(size_t size, std::align_val_t align)
+{
+    return checked(allocate(size, align));
+}
+void *operator new[](size_t size, std::align_val_t align)
+{
+    return checked(allocate(size, align));
+}
+void *operator new(size_t size, std::align_val_t align,
+                   const std::nothrow_t &) noexcept
+{
+    return allocate(size, align);
+}
+void *operator new[](size_t size, std::align_val_t align,
+                     const std::nothrow_t &) noexcept
+{
+    return allocate(size, align);
+}
+
+void operator delete(void *memory) noexcept { deallocate(memory); }
+void operator delete[](void *memory) noexcept { deallocate(memory); }
+void operator delete(void *memory, size_t) noexcept { deallocate(memory); }
+void operator delete[](void *memory, size_t) noexcept { deallocate(memory); }
+void operator delete(void *memory, const std::nothrow_t &) noexcept
+{
+    deallocate(memory);
+}
+void operator delete[](void *memory, const std::nothrow_t &) noexcept
+{
+    deallocate(memory);
+}
+void operator delete(void *memory, std::align_val_t align) noexcept
+{
+    deallocate(memory, align);
+}
+void operator delete[](void *memory, std::align_val_t align) noexcept
+{
+    deallocate(memory, align);
+}
+void operator delete(void *memory, size_t, std::align_val_t align) noexcept
+{
+    deallocate(memory, align);
+}
+void operator delete[](void *memory, size_t, std::align_val_t align) noexcept
+{
+    deallocate(memory, align);
+}
+void operator delete(void *memory, std::align_val_t align,
+                     const std::nothrow_t &) noexcept
+{
+    deallocate(memory, align);
+}
+void operator delete[](void *memory, std::align_val_t align,
+                       const std::nothrow_t &) noexcept
+{
+    deallocate(memory, align);
+}
+
+/// @brief Count the allocations made by one call of run
+template <typename F> size_t count(F &&run)
+{
+    size_t before = allocations;
+    run();
+    return allocations - before;
+}
+
+/// @brief Print one count, with its per row rate
+void report(const char *name, const size_t &count, const size_t &rows)
+{
+    std::cout << name << count << " allocations, "
+              << static_cast<double>(count) / rows << " per row\n";
+}
+
+int main(int argc, char *argv[])
+{
+    size_t rows = argc > 1 ? std::stoul(argv[1]) : 1000000;
+    std::string path = argc > 2 ? argv[2] : "test/data/weekly_AAPL.csv";
+
+    // Row by row, the pre-columnar layout: one vector per row, plus the
+    // copy pushBack(const TimePair &) used to make
+    std::vector<avapi::TimePair> pairs;
+    size_t row_wise = count([&]() {
+        pairs.reserve(rows);
+        for (size_t i = 0; i < rows; ++i) {
+            avapi::TimePair pair(i, {1.0, 2.0, 0.5, 1.5, 1000.0});
+            pairs.push_back(pair);
+        }
+    });
+    report("std::vector<TimePair> copies:  ", row_wise, rows);
+
+    avapi::TimeSeries series;
+    size_t reserved = count([&]() {
+        series.reserve(rows);
+        series.emplaceBack(0, 1.0, 2.0, 0.5, 1.5, 1000.0);
+    });
+    size_t emplaced = count([&]() {
+        for (size_t i = 1; i < rows; ++i)
+            series.emplaceBack(i, 1.0, 2.0, 0.5, 1.5, 1000.0);
+    });
+    report("reserve() + first row:         ", reserved, rows);
+    report("emplaceBack() after reserve(): ", emplaced, rows);
+
+    size_t pushed = count([&]() {
+        avapi::TimeSeries moved;
+        moved.reserve(pairs.size());
+        for (auto &pair : pairs)
+            moved.pushBack(std::move(pair));
+    });
+    report("pushBack(TimePair &&):         ", pushed, rows);
+
+    size_t handed = count([&]() {
+        avapi::TimeSeries owner = std::move(series);
+        series = std::move(owner);
+    });
+    size_t copied = count([&]() { avapi::TimeSeries copy = series; });
+    std::cout << "move TimeSeries:                " << handed
+              << " allocations\n"
+              << "copy TimeSeries:                " << copied
+              << " allocations\n";
+
+    avapi::TimeSeries parsed;
+    size_t parsing = count([&]() { parsed = avapi::parseCsvFile(path); });
+    report("parseCsvFile():                ", parsing, parsed.rowCount());
+    return 0;
+}
@@ -0,0 +1,84 @@
+// Benchmark: loading a universe of symbols into avapi::TimeSeries with their
+// columns on the default heap, or all drawn from one
+// std::pmr::monotonic_buffer_resource, then tearing the universe down.
+// Peak RSS is per process, so each mode is its own run.
+//
+// usage: bench08_Arena heap|arena [symbols] [file]
+//        (default = arena, 5000, "test/data/weekly_AAPL.csv")
+#include <fstream>
+#include <iostream>
+#include <memory_resource>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "avapi/misc.hpp"
+#include "generate.hpp"
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+/// @brief Peak resident set size of the process in MB, 0 where unknown
+double peakRss()
+{
+#ifndef _WIN32
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return usage.ru_maxrss / (1024.0 * 1024.0);
+#else
+    return usage.ru_maxrss / 1024.0;
+#endif
+#else
+    return 0;
+#endif
+}
+
+int main(int argc, char *argv[])
+{
+    bool arena = argc <= 1 || std::string(argv[1]) != "heap";
+    size_t symbols = argc > 2 ? std::stoul(argv[2]) : 5000;
+    std::string path = argc > 3 ? argv[3] : "test/data/weekly_AAPL.csv";
+
+    // Every symbol gets the same body, as if it had just been downloaded
+    std::ifstream file(path, std::ios::binary);
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    std::string data = buffer.str();
+
+    std::pmr::monotonic_buffer_resource pool;
+    std::pmr::memory_resource *resource =
+        arena ? &pool : std::pmr::get_default_resource();
+
+    std::vector<avapi::TimeSeries> universe;
+    universe.reserve(symbols);
+    double load = seconds([&]() {
+        for (size_t i = 0; i < symbols; ++i)
+            universe.push_back(avapi::parseCsvString(data, resource));
+    });
+
+    // Copying isolates the allocations from the parsing
+    std::vector<avapi::TimeSeries> copies;
+    copies.reserve(symbols);
+    double copy = seconds([&]() {
+        for (auto &series : universe)
+            copies.emplace_back(series, resource);
+    });
+
+    size_t rows = 0;
+    for (auto &series : universe)
+        rows += series.rowCount();
+    double rss = peakRss();
+
+    // The arena hands its memory back in one release()
+    double teardown = seconds([&]() {
+        universe.clear();
+        copies.clear();
+        pool.release();
+    });
+
+    std::cout << (arena ? "arena: " : "heap:  ") << symbols << " symbols, "
+              << rows << " rows, load " << load << " s, copy " << copy
+              << " s, teardown " << teardown << " s, peak RSS " << rss
+              << " MB\n";
+    return 0;
+}
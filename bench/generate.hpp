@@ -0,0 +1,47 @@
+// Shared helpers of the avapi benchmarks
+#ifndef BENCH_GENERATE_H
+#define BENCH_GENERATE_H
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+/// @brief Write an intraday_TSLA.csv shaped file of roughly the given size
+inline void generate(const std::string &path, const size_t &megabytes)
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << "timestamp,open,high,low,close,volume\n";
+
+    const size_t target = megabytes * 1024 * 1024;
+    size_t written = 0;
+    char line[128];
+
+    // 15min bars, newest first, 16 bars per day
+    for (long day = 0; written < target; ++day) {
+        long y = 2021 - day / 336 % 40;
+        long m = 12 - day / 28 % 12;
+        long d = 28 - day % 28;
+        for (int bar = 15; bar >= 0 && written < target; --bar) {
+            double open = 700.0 + (day * 7 + bar) % 1000 / 10.0;
+            int n = std::snprintf(
+                line, sizeof(line),
+                "%04ld-%02ld-%02ld %02d:%02d:00,%.4f,%.4f,%.4f,%.4f,%ld\n", y,
+                m, d, 16 + bar / 4, bar % 4 * 15, open, open + 1.25,
+                open - 0.75, open + 0.5, 1000 + (day * 13 + bar) % 90000);
+            file.write(line, n);
+            written += static_cast<size_t>(n);
+        }
+    }
+}
+
+/// @brief Time one call of run
+template <typename F> double seconds(F &&run)
+{
+    auto start = std::chrono::steady_clock::now();
+    run();
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+#endif
@@ -1,3 +1,5 @@
 #include "avapi/misc.hpp"
 #include "avapi/Company/Company.hpp"
-#include "avapi/Crypto/Crypto.hpp"
\ No newline at end of file
+#include "avapi/Crypto/Crypto.hpp"
+#include "avapi/BatchFetch.hpp"
+#include "avapi/Transport.hpp"
\ No newline at end of file
@@ -3,6 +3,16 @@
 #include <vector>
 #include <string>
 #include <iomanip>
+#include <memory>
+#include "avapi/CsvProjection.hpp"
+#include "avapi/CurlSession.hpp"
+#include "avapi/RequestScheduler.hpp"
+#include "avapi/ResponseCache.hpp"
+#include "avapi/ResponseStatus.hpp"
+#include "avapi/SingleFlight.hpp"
+#include "avapi/TimestampParser.hpp"
+#include "avapi/Transport.hpp"
+#include "avapi/Container/TimeSeries.hpp"
 
 namespace avapi {
 
@@ -35,6 +45,7 @@ public:
 
     // Build and return the url query
     std::string buildQuery();
+    std::string canonicalQuery();
 
 private:
     Query m_query;
@@ -55,16 +66,55 @@ public:
     void setOutputSize(const SeriesSize &size);
     std::string output_size;
 
+    // Scheduling priority of this ApiCall's requests (default = NORMAL)
+    Priority priority;
+
+    // Parse csv responses while they download (default = false)
+    bool streaming;
+
+    // Where requests are sent (default = Transport::defaultTransport())
+    std::shared_ptr<Transport> transport;
+
     void setFieldValue(const enum Url::Field &field, const std::string &value);
     std::string getValue(const enum Url::Field &field);
 
+    std::string buildQuery();
+    std::string cacheKey();
     std::string curlQuery();
+    std::string curlQuery(const Priority &priority);
+    TimeSeries curlQueryCsv();
+    TimeSeries curlQueryCsv(const CsvProjection &projection,
+                            const TimeZone &zone = TimeZone::US_EASTERN);
+
+    /// @brief   Requests a csv url and parses it into a TimeSeries
+    /// @param   crypto Whether the csv data is from a cryptocurrency
+    template <typename Bool, typename = IfBool<Bool>>
+    TimeSeries curlQueryCsv(const Bool &crypto)
+    {
+        if (crypto)
+            return curlQueryCsv(CsvProjection::crypto(), TimeZone::UTC);
+        return curlQueryCsv();
+    }
     void resetQuery();
 
+    // What the last response of this ApiCall was, errors included
+    const ResponseStatus &lastStatus() { return m_status; }
+
+    // Connection reuse counters of the shared avapi::CurlSession
+    static ConnectionStats connectionStats();
+
+    // Counters of identical concurrent requests served by one fetch
+    static FlightStats flightStats();
+
 private:
+    std::string flightKey();
+    std::string fetch(const Priority &priority);
+    TimeSeries fetchCsv(const CsvProjection &projection, const TimeZone &zone);
+
     Url *url = nullptr;
-    static size_t WriteMemoryCallback(void *ptr, size_t size, size_t nmemb,
-                                      void *data);
+    ResponseStatus m_status;
+    static SingleFlight<std::string> m_bodyFlights;
+    static SingleFlight<TimeSeries> m_seriesFlights;
 };
 } // namespace avapi
 #endif
\ No newline at end of file
@@ -0,0 +1,51 @@
+#ifndef BATCHFETCH_H
+#define BATCHFETCH_H
+#include <memory>
+#include <string>
+#include <vector>
+#include "avapi/ApiCall.hpp"
+#include "avapi/Container/TimeSeries.hpp"
+
+namespace avapi {
+
+/// @brief One TimeSeries to fetch within a BatchFetch. A non-empty market
+/// requests a cryptocurrency series, otherwise a stock series.
+struct SeriesRequest {
+    std::string symbol;
+    SeriesType type = SeriesType::DAILY;
+    bool adjusted = false;
+    std::string market = "";
+    std::string interval = "30min";
+};
+
+/// @brief The outcome of one SeriesRequest
+struct SeriesResult {
+    SeriesRequest request;
+    bool ok = false;
+    TimeSeries series;
+    std::string error;
+};
+
+class BatchFetch {
+public:
+    BatchFetch();
+    explicit BatchFetch(const std::string &key,
+                        const size_t &max_concurrent = 8);
+
+    std::string api_key;
+    size_t max_concurrent;
+
+    // Scheduling priority of the batch's requests (default = NORMAL)
+    Priority priority;
+
+    // Where requests are sent (default = Transport::defaultTransport())
+    std::shared_ptr<Transport> transport;
+
+    void setOutputSize(const SeriesSize &size);
+    std::string output_size;
+
+    std::vector<SeriesResult> fetch(const std::vector<SeriesRequest> &requests);
+};
+
+} // namespace avapi
+#endif
@@ -0,0 +1,71 @@
+#ifndef FIXEDTIMESERIES_H
+#define FIXEDTIMESERIES_H
+#include <cstdint>
+#include <ctime>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "avapi/Container/TimeSeries.hpp"
+
+namespace avapi {
+
+class CsvTokenizer;
+
+/// @brief A TimeSeries whose values are kept as integer ticks of
+/// 10^-decimals, so Alpha Vantage's 4 (8 for cryptocurrencies) decimal
+/// prices are stored, summed and printed exactly. Each column is one
+/// contiguous vector.
+class FixedTimeSeries {
+public:
+    explicit FixedTimeSeries(const unsigned &decimals = 4);
+
+    void reserve(const size_t &rows);
+    void appendRow(const std::time_t &timestamp,
+                   const std::vector<int64_t> &ticks);
+    void reverseData();
+
+    size_t rowCount() { return m_timestamps.size(); }
+    size_t colCount() { return m_columns.size() + 1; }
+
+    unsigned decimals() const { return m_decimals; }
+    int64_t scale() const { return m_scale; }
+
+    std::time_t timestamp(const size_t &row) { return m_timestamps[row]; }
+    int64_t ticks(const size_t &row, const size_t &col);
+    double value(const size_t &row, const size_t &col);
+    const std::vector<std::time_t> &timestamps() { return m_timestamps; }
+    const std::vector<int64_t> &column(const size_t &col);
+
+    int64_t sum(const size_t &col);
+    int64_t min(const size_t &col);
+    int64_t max(const size_t &col);
+
+    TimeSeries toTimeSeries();
+    std::string toString(const int64_t &ticks) const;
+    void printData(const size_t &count = 0);
+
+    static int64_t toTicks(std::string_view cell, const unsigned &decimals);
+
+    std::string symbol;
+    SeriesType type;
+    std::string market;
+
+    std::string title;
+    std::vector<std::string> headers;
+
+    friend std::ostream &operator<<(std::ostream &os,
+                                    const FixedTimeSeries &series);
+
+private:
+    // Filled in place by CsvTokenizer::parseFixed()
+    friend class CsvTokenizer;
+
+    unsigned m_decimals;
+    int64_t m_scale;
+    std::vector<std::time_t> m_timestamps;
+    std::vector<std::vector<int64_t>> m_columns;
+};
+
+} // namespace avapi
+#endif
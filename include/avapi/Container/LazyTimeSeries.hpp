@@ -0,0 +1,59 @@
+#ifndef LAZYTIMESERIES_H
+#define LAZYTIMESERIES_H
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "avapi/CsvProjection.hpp"
+#include "avapi/CsvTokenizer.hpp"
+#include "avapi/TimestampParser.hpp"
+#include "avapi/Container/TimeSeries.hpp"
+
+namespace avapi {
+
+/// @brief A csv series that keeps the raw response and only parses what is
+/// read. Construction finds the line boundaries and parses the header, a row
+/// is parsed on its first operator[] and a column on its first column(),
+/// both are kept for later reads. Not safe for concurrent use, since reads
+/// fill the caches.
+class LazyTimeSeries {
+public:
+    explicit LazyTimeSeries(std::string data);
+    template <typename Bool, typename = IfBool<Bool>>
+    LazyTimeSeries(std::string data, const Bool &crypto)
+        : m_body(std::make_shared<const std::string>(std::move(data))),
+          m_tokenizer(crypto)
+    {
+        indexLines();
+    }
+    LazyTimeSeries(std::string data, const CsvProjection &projection,
+                   const TimeZone &zone = TimeZone::US_EASTERN);
+
+    size_t rowCount() { return m_lines.size(); }
+    size_t colCount() { return headers.size(); }
+
+    const TimePair &operator[](size_t i);
+    const std::vector<double> &column(const size_t &index);
+    const std::vector<std::time_t> &timestamps();
+
+    // Parse every row, as parseCsvString() would have
+    TimeSeries materialize();
+
+    std::vector<std::string> headers;
+
+private:
+    void indexLines();
+
+    std::shared_ptr<const std::string> m_body;
+    std::vector<std::string_view> m_lines;
+    CsvTokenizer m_tokenizer;
+
+    std::vector<TimePair> m_rows;
+    std::vector<bool> m_parsed;
+    std::unordered_map<size_t, std::vector<double>> m_columns;
+    std::vector<std::time_t> m_timestamps;
+};
+
+} // namespace avapi
+#endif
@@ -0,0 +1,193 @@
+#ifndef SERIES_H
+#define SERIES_H
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <ctime>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "avapi/CsvProjection.hpp"
+#include "avapi/TimestampParser.hpp"
+#include "avapi/Container/TimeSeries.hpp"
+
+namespace avapi {
+
+// Schemas of the Alpha Vantage csv layouts. Each one names its csv columns,
+// gives their index in Row as constexpr constants and lists the matching Row
+// members in the same order, so every field is read and accessed at a
+// fixed offset.
+
+/// @brief Intraday, and non adjusted daily, weekly and monthly series
+struct OHLCV {
+    struct Row {
+        std::time_t timestamp;
+        double open;
+        double high;
+        double low;
+        double close;
+        int64_t volume;
+    };
+
+    static constexpr size_t OPEN = 0, HIGH = 1, LOW = 2, CLOSE = 3,
+                            VOLUME = 4;
+    static constexpr std::array<const char *, 5> names = {
+        "open", "high", "low", "close", "volume"};
+    static constexpr auto fields = std::make_tuple(
+        &Row::open, &Row::high, &Row::low, &Row::close, &Row::volume);
+    static constexpr TimeZone zone = TimeZone::US_EASTERN;
+};
+
+/// @brief Adjusted daily series
+struct AdjustedDaily {
+    struct Row {
+        std::time_t timestamp;
+        double open;
+        double high;
+        double low;
+        double close;
+        double adj_close;
+        int64_t volume;
+        double dividends;
+        double split_coeff;
+    };
+
+    static constexpr size_t OPEN = 0, HIGH = 1, LOW = 2, CLOSE = 3,
+                            ADJ_CLOSE = 4, VOLUME = 5, DIVIDENDS = 6,
+                            SPLIT_COEFF = 7;
+    static constexpr std::array<const char *, 8> names = {
+        "open",      "high",   "low",       "close",
+        "adj_close", "volume", "dividends", "split_coeff"};
+    static constexpr auto fields = std::make_tuple(
+        &Row::open, &Row::high, &Row::low, &Row::close, &Row::adj_close,
+        &Row::volume, &Row::dividends, &Row::split_coeff);
+    static constexpr TimeZone zone = TimeZone::US_EASTERN;
+};
+
+/// @brief Adjusted weekly and monthly series
+struct AdjustedWeekly {
+    struct Row {
+        std::time_t timestamp;
+        double open;
+        double high;
+        double low;
+        double close;
+        double adj_close;
+        int64_t volume;
+        double dividends;
+    };
+
+    static constexpr size_t OPEN = 0, HIGH = 1, LOW = 2, CLOSE = 3,
+                            ADJ_CLOSE = 4, VOLUME = 5, DIVIDENDS = 6;
+    static constexpr std::array<const char *, 7> names = {
+        "open", "high", "low", "close", "adj_close", "volume", "dividends"};
+    static constexpr auto fields = std::make_tuple(
+        &Row::open, &Row::high, &Row::low, &Row::close, &Row::adj_close,
+        &Row::volume, &Row::dividends);
+    static constexpr TimeZone zone = TimeZone::US_EASTERN;
+};
+
+/// @brief Cryptocurrency series, prices in the first market listed, as
+/// CsvProjection::crypto(). Volumes are fractional, so kept as double.
+struct CryptoOHLCV {
+    struct Row {
+        std::time_t timestamp;
+        double open;
+        double high;
+        double low;
+        double close;
+        double volume;
+    };
+
+    static constexpr size_t OPEN = 0, HIGH = 1, LOW = 2, CLOSE = 3,
+                            VOLUME = 4;
+    static constexpr std::array<const char *, 5> names = {
+        "open", "high", "low", "close", "volume"};
+    static constexpr auto fields = std::make_tuple(
+        &Row::open, &Row::high, &Row::low, &Row::close, &Row::volume);
+    static constexpr TimeZone zone = TimeZone::UTC;
+};
+
+/// @brief A time series whose column layout is fixed at compile time by a
+/// Schema (OHLCV, AdjustedDaily, AdjustedWeekly or CryptoOHLCV). Rows are
+/// plain Schema::Row structs stored back to back, so series[i].close or
+/// get<OHLCV::CLOSE>(i) is a direct load, never a header lookup.
+template <typename Schema> class Series {
+public:
+    typedef typename Schema::Row Row;
+    static constexpr size_t COLUMNS = Schema::names.size();
+
+    Series() : type(SeriesType::DAILY), market("USD") {}
+
+    void pushBack(const Row &row) { m_rows.push_back(row); }
+    void reserve(const size_t &rows) { m_rows.reserve(rows); }
+    void reverseData() { std::reverse(m_rows.begin(), m_rows.end()); }
+
+    size_t rowCount() const { return m_rows.size(); }
+    size_t colCount() const { return COLUMNS + 1; }
+
+    Row &operator[](size_t i) { return m_rows[i]; }
+    const Row &operator[](size_t i) const { return m_rows[i]; }
+    typename std::vector<Row>::iterator begin() { return m_rows.begin(); }
+    typename std::vector<Row>::iterator end() { return m_rows.end(); }
+
+    /// @brief Access a field by its constexpr index, e.g. OHLCV::CLOSE
+    template <size_t I> auto &get(const size_t &row)
+    {
+        return m_rows[row].*std::get<I>(Schema::fields);
+    }
+
+    /// @brief The header names of the columns, timestamp first
+    static std::vector<std::string> headers()
+    {
+        std::vector<std::string> names = {"timestamp"};
+        names.insert(names.end(), Schema::names.begin(), Schema::names.end());
+        return names;
+    }
+
+    /// @brief The CsvProjection keeping this Schema's columns
+    static CsvProjection projection()
+    {
+        return CsvProjection(std::vector<std::string>(Schema::names.begin(),
+                                                      Schema::names.end()));
+    }
+
+    /// @brief Convert to a runtime typed TimeSeries
+    TimeSeries toTimeSeries() const
+    {
+        TimeSeries series;
+        series.symbol = symbol;
+        series.type = type;
+        series.market = market;
+        series.title = title;
+        series.headers = headers();
+        series.reserve(m_rows.size());
+
+        std::vector<double> values(COLUMNS);
+        for (auto &row : m_rows) {
+            toValues(row, values, std::make_index_sequence<COLUMNS>());
+            series.appendRow(row.timestamp, values);
+        }
+        return series;
+    }
+
+    std::string symbol;
+    SeriesType type;
+    std::string market;
+    std::string title;
+
+private:
+    template <size_t... I>
+    static void toValues(const Row &row, std::vector<double> &values,
+                         std::index_sequence<I...>)
+    {
+        ((values[I] = static_cast<double>(row.*std::get<I>(Schema::fields))),
+         ...);
+    }
+
+    std::vector<Row> m_rows;
+};
+
+} // namespace avapi
+#endif
@@ -0,0 +1,33 @@
+#ifndef SPAN_H
+#define SPAN_H
+#include <cstddef>
+
+namespace avapi {
+
+/// @brief A contiguous run of elements owned elsewhere, as std::span of
+/// C++20. Valid until its owner is resized.
+template <typename T> class Span {
+public:
+    Span() = default;
+    Span(T *data, const size_t &size) : m_data(data), m_size(size) {}
+
+    T *data() const { return m_data; }
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+    T *begin() const { return m_data; }
+    T *end() const { return m_data + m_size; }
+    T &operator[](size_t i) const { return m_data[i]; }
+
+    Span subspan(const size_t &offset, const size_t &count) const
+    {
+        return Span(m_data + offset, count);
+    }
+
+private:
+    T *m_data = nullptr;
+    size_t m_size = 0;
+};
+
+} // namespace avapi
+#endif
@@ -1,5 +1,6 @@
 #ifndef TIMEPAIR_H
 #define TIMEPAIR_H
+#include <utility>
 #include <vector>
 #include <iomanip>
 
@@ -13,10 +14,16 @@ public:
     {
     }
 
-    TimePair(const TimePair &pair) : timestamp(pair.timestamp), data(pair.data)
+    TimePair(const std::time_t &time, std::vector<double> &&data)
+        : timestamp(time), data(std::move(data))
     {
     }
 
+    TimePair(const TimePair &pair) = default;
+    TimePair(TimePair &&pair) noexcept = default;
+    TimePair &operator=(const TimePair &pair) = default;
+    TimePair &operator=(TimePair &&pair) noexcept = default;
+
     std::time_t timestamp;
     std::vector<double> data;
     double &operator[](size_t i) { return data[i]; }
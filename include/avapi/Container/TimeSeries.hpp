@@ -1,40 +1,275 @@
 #ifndef TIMESERIES_H
 #define TIMESERIES_H
+#include <iterator>
+#include <memory_resource>
 #include <string>
 #include <vector>
+#include "avapi/Container/Span.hpp"
 #include "avapi/Container/TimePair.hpp"
 
 namespace avapi {
 
 enum class SeriesType { INTRADAY = 0, DAILY, WEEKLY, MONTHLY };
 
+class CsvTokenizer;
+
+/// @brief A time series stored by column: one contiguous array of
+/// timestamps and one contiguous array per value column, so scanning a
+/// column reads consecutive memory and rows cost no allocation of their own.
+/// Rows are still reachable through operator[], as a view across the
+/// columns. The columns are drawn from a std::pmr::memory_resource, the
+/// default heap unless one is given.
 class TimeSeries {
 public:
+    typedef std::pmr::vector<double> Column;
+    typedef std::pmr::vector<Column> Columns;
+
+    /// @brief The values of one row, read across the columns
+    class Values {
+    public:
+        Values(Columns &columns, const size_t &row)
+            : m_columns(&columns), m_row(row)
+        {
+        }
+
+        size_t size() const { return m_columns->size(); }
+        bool empty() const { return m_columns->empty(); }
+        double &operator[](size_t i) const { return (*m_columns)[i][m_row]; }
+
+        /// @brief Walks the row's values, one column at a time. It points
+        /// into the columns, not at the Values, so it outlives a temporary
+        /// Row.
+        class iterator {
+        public:
+            typedef std::forward_iterator_tag iterator_category;
+            typedef double value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef double *pointer;
+            typedef double &reference;
+
+            iterator(Columns &columns, const size_t &row, const size_t &i)
+                : m_columns(&columns), m_row(row), m_i(i)
+            {
+            }
+
+            double &operator*() const { return (*m_columns)[m_i][m_row]; }
+            double *operator->() const { return &(*m_columns)[m_i][m_row]; }
+            iterator &operator++()
+            {
+                ++m_i;
+                return *this;
+            }
+            iterator operator++(int)
+            {
+                iterator previous = *this;
+                ++m_i;
+                return previous;
+            }
+            bool operator==(const iterator &other) const
+            {
+                return m_columns == other.m_columns &&
+                       m_row == other.m_row && m_i == other.m_i;
+            }
+            bool operator!=(const iterator &other) const
+            {
+                return !(*this == other);
+            }
+
+        private:
+            Columns *m_columns;
+            size_t m_row;
+            size_t m_i;
+        };
+
+        iterator begin() const { return iterator(*m_columns, m_row, 0); }
+        iterator end() const
+        {
+            return iterator(*m_columns, m_row, size());
+        }
+
+        operator std::vector<double>() const
+        {
+            std::vector<double> values(size());
+            for (size_t i = 0; i < values.size(); ++i)
+                values[i] = (*this)[i];
+            return values;
+        }
+
+        friend bool operator==(const Values &lhs, const Values &rhs)
+        {
+            return std::vector<double>(lhs) == std::vector<double>(rhs);
+        }
+        friend bool operator==(const Values &lhs,
+                               const std::vector<double> &rhs)
+        {
+            return std::vector<double>(lhs) == rhs;
+        }
+        friend bool operator==(const std::vector<double> &lhs,
+                               const Values &rhs)
+        {
+            return lhs == std::vector<double>(rhs);
+        }
+        friend bool operator!=(const Values &lhs, const Values &rhs)
+        {
+            return !(lhs == rhs);
+        }
+        friend bool operator!=(const Values &lhs,
+                               const std::vector<double> &rhs)
+        {
+            return !(lhs == rhs);
+        }
+        friend bool operator!=(const std::vector<double> &lhs,
+                               const Values &rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+    private:
+        Columns *m_columns;
+        size_t m_row;
+    };
+
+    /// @brief View of one row, valid until the TimeSeries is resized
+    class Row {
+    public:
+        Row(std::time_t &time, const Values &values)
+            : timestamp(time), data(values)
+        {
+        }
+
+        std::time_t &timestamp;
+        Values data;
+
+        double &operator[](size_t i) const { return data[i]; }
+        operator TimePair() const { return TimePair(timestamp, data); }
+    };
+
+    class View;
+
     TimeSeries();
+    explicit TimeSeries(std::pmr::memory_resource *resource);
     TimeSeries(const std::vector<avapi::TimePair> &data);
     TimeSeries(const TimeSeries &series);
+    TimeSeries(const TimeSeries &series, std::pmr::memory_resource *resource);
+    TimeSeries(TimeSeries &&series) noexcept;
+    TimeSeries &operator=(const TimeSeries &series);
+    TimeSeries &operator=(TimeSeries &&series);
+
+    // Where the columns are allocated from
+    std::pmr::memory_resource *resource() const;
 
     void pushBack(const TimePair &pair);
+    void pushBack(TimePair &&pair);
+    void appendRow(const std::time_t &timestamp,
+                   const std::vector<double> &data);
+    void appendRow(const std::time_t &timestamp, const double *data,
+                   const size_t &count);
+
+    /// @brief Append a row from its values, e.g. emplaceBack(t, o, h, l, c)
+    template <typename... Values>
+    void emplaceBack(const std::time_t &timestamp, const Values &...values)
+    {
+        const double row[] = {static_cast<double>(values)..., 0.0};
+        appendRow(timestamp, row, sizeof...(Values));
+    }
+
+    void append(const TimeSeries &rows);
+    void reserve(const size_t &rows);
     void reverseData();
+    bool merge(const TimeSeries &update);
     void printData(const size_t &count = 0);
 
     size_t rowCount();
     size_t colCount();
+    size_t capacity();
+
+    // Whole columns, valid until the TimeSeries is resized
+    Span<std::time_t> timestamps();
+    Span<double> column(const size_t &index);
+    Span<double> column(const std::string &name);
+    Span<double> open() { return column("open"); }
+    Span<double> high() { return column("high"); }
+    Span<double> low() { return column("low"); }
+    Span<double> close() { return column("close"); }
+    Span<double> volume() { return column("volume"); }
+
+    // Time range lookups, rows must be sorted either way by timestamp
+    bool isDescending();
+    size_t lowerBound(const std::time_t &time);
+    View slice(const std::time_t &from, const std::time_t &to);
+    View last(const size_t &count);
+    View rows(const size_t &first, const size_t &last);
 
     std::string symbol;
     SeriesType type;
     bool is_adjusted;
     std::string market;
 
+    // The INTRADAY interval, e.g. "30min", empty for other types
+    std::string interval;
+
     std::string title;
     std::vector<std::string> headers;
 
-    TimePair &operator[](size_t i) { return data_series[i]; }
+    Row operator[](size_t i)
+    {
+        return Row(m_timestamps[i], Values(m_columns, i));
+    }
     friend std::ostream &operator<<(std::ostream &os, const TimeSeries &series);
 
 private:
-    std::vector<TimePair> data_series;
+    // Filled in place by CsvTokenizer::parseBody()
+    friend class CsvTokenizer;
+
+    void copyRows(const TimeSeries &from, const size_t &first,
+                  const size_t &last, const bool &reversed);
+
+    std::pmr::vector<std::time_t> m_timestamps;
+    Columns m_columns;
+};
+
+/// @brief A run of consecutive rows of a TimeSeries, sharing its storage.
+/// Rows and columns are in the parent's order. Valid until the parent is
+/// resized.
+class TimeSeries::View {
+public:
+    View(TimeSeries &series, const size_t &first, const size_t &last)
+        : m_series(&series), m_first(first), m_count(last - first)
+    {
+    }
+
+    size_t rowCount() const { return m_count; }
+    size_t offset() const { return m_first; }
+    bool empty() const { return m_count == 0; }
+
+    Row operator[](size_t i) { return (*m_series)[m_first + i]; }
+
+    Span<std::time_t> timestamps()
+    {
+        return m_series->timestamps().subspan(m_first, m_count);
+    }
+    Span<double> column(const size_t &index)
+    {
+        return m_series->column(index).subspan(m_first, m_count);
+    }
+    Span<double> column(const std::string &name)
+    {
+        return m_series->column(name).subspan(m_first, m_count);
+    }
+    Span<double> open() { return column("open"); }
+    Span<double> high() { return column("high"); }
+    Span<double> low() { return column("low"); }
+    Span<double> close() { return column("close"); }
+    Span<double> volume() { return column("volume"); }
+
+    // Copy the rows into a TimeSeries of their own
+    TimeSeries toTimeSeries() const;
+
+private:
+    TimeSeries *m_series;
+    size_t m_first;
+    size_t m_count;
 };
 
 } // namespace avapi
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,51 @@
+#ifndef CSVPROJECTION_H
+#define CSVPROJECTION_H
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace avapi {
+
+/// @brief Restricts the crypto flag overloads found next to CsvProjection
+/// ones to real bools. A braced list such as {"close"} or {4} cannot deduce
+/// a template argument, so it always selects the CsvProjection overload
+/// instead of converting to bool.
+template <typename Bool>
+using IfBool = typename std::enable_if<std::is_same<Bool, bool>::value>::type;
+
+/// @brief The columns a CsvTokenizer keeps. Unselected cells are skipped
+/// while tokenizing, they are never converted or stored. Columns are chosen
+/// by header name or by index, the timestamp column is always kept and the
+/// kept columns stay in file order. A name matches a header equal to it, to
+/// its normalized form or with a currency suffix ("close" matches
+/// "close (CNY)"), the first match wins. Names no header matches are
+/// ignored. Indices count from the timestamp column (0).
+class CsvProjection {
+public:
+    // Keep every column
+    CsvProjection() = default;
+    CsvProjection(std::initializer_list<std::string> names);
+    CsvProjection(const std::vector<std::string> &names);
+    CsvProjection(std::initializer_list<size_t> indices);
+
+    // open, high, low and close in the market currency, and volume
+    static CsvProjection crypto();
+    // The columns an earlier parse kept, from its TimeSeries::headers
+    static CsvProjection matching(const std::vector<std::string> &headers);
+
+    std::vector<bool>
+    select(const std::vector<std::string_view> &headers) const;
+    bool keepsAll() const { return m_names.empty() && m_indices.empty(); }
+    std::string key() const;
+
+private:
+    static bool matches(std::string_view name, std::string_view header);
+
+    std::vector<std::string> m_names;
+    std::vector<size_t> m_indices;
+};
+
+} // namespace avapi
+#endif
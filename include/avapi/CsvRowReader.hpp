@@ -0,0 +1,98 @@
+#ifndef CSVROWREADER_H
+#define CSVROWREADER_H
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "avapi/CsvProjection.hpp"
+#include "avapi/CsvTokenizer.hpp"
+#include "avapi/TimestampParser.hpp"
+#include "avapi/Container/TimePair.hpp"
+
+namespace avapi {
+
+/// @brief Reads an Alpha Vantage csv file one row at a time through a fixed
+/// size buffer, so memory use does not grow with the file. Every row is
+/// parsed into the same TimePair, which is only valid until the next read.
+/// Rows are handed out by next(), by forEach() or by iterating the reader.
+class CsvRowReader {
+public:
+    typedef std::function<void(const TimePair &)> RowCallback;
+
+    explicit CsvRowReader(const std::string &file_path);
+    template <typename Bool, typename = IfBool<Bool>>
+    CsvRowReader(const std::string &file_path, const Bool &crypto)
+        : m_tokenizer(crypto)
+    {
+        open(file_path);
+    }
+    CsvRowReader(const std::string &file_path, const CsvProjection &projection,
+                 const TimeZone &zone = TimeZone::US_EASTERN);
+
+    CsvRowReader(const CsvRowReader &) = delete;
+    CsvRowReader &operator=(const CsvRowReader &) = delete;
+
+    const std::vector<std::string> &headers() { return m_headers; }
+    size_t rowsRead() { return m_rows; }
+
+    bool next(TimePair &row);
+    size_t forEach(const RowCallback &callback);
+
+    class iterator {
+    public:
+        typedef std::input_iterator_tag iterator_category;
+        typedef TimePair value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const TimePair *pointer;
+        typedef const TimePair &reference;
+
+        iterator() = default;
+        explicit iterator(CsvRowReader *reader) : m_reader(reader) { ++*this; }
+
+        reference operator*() const { return m_reader->m_row; }
+        pointer operator->() const { return &m_reader->m_row; }
+        iterator &operator++()
+        {
+            if (!m_reader->next(m_reader->m_row))
+                m_reader = nullptr;
+            return *this;
+        }
+
+        bool operator==(const iterator &other) const
+        {
+            return m_reader == other.m_reader;
+        }
+        bool operator!=(const iterator &other) const
+        {
+            return m_reader != other.m_reader;
+        }
+
+    private:
+        CsvRowReader *m_reader = nullptr;
+    };
+
+    // Single pass, begin() continues from the current row
+    iterator begin() { return iterator(this); }
+    iterator end() { return iterator(); }
+
+private:
+    void open(const std::string &file_path);
+    bool nextLine(std::string_view &line);
+    bool fill();
+
+    std::ifstream m_file;
+    std::vector<char> m_buffer;
+    size_t m_begin = 0;
+    size_t m_end = 0;
+    bool m_eof = false;
+
+    CsvTokenizer m_tokenizer;
+    std::vector<std::string> m_headers;
+    TimePair m_row;
+    size_t m_rows = 0;
+};
+
+} // namespace avapi
+#endif
@@ -0,0 +1,39 @@
+#ifndef CSVSCANNER_H
+#define CSVSCANNER_H
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace avapi {
+
+/// @brief Instruction sets the CsvScanner can use
+enum class SimdLevel { SCALAR = 0, SSE2, AVX2 };
+
+/// @brief Builds the structural index of a csv block: the offset of every
+/// ',' and '\n', in order. The block is compared 16 (SSE2) or 32 (AVX2)
+/// bytes at a time and the matches are pulled out of the comparison mask,
+/// so the tokenizer walks the index instead of searching byte by byte. The
+/// fastest level the CPU supports is picked at runtime, targets without
+/// SSE2 fall back to a scalar loop. Blocks must be smaller than 4 GB.
+class CsvScanner {
+public:
+    explicit CsvScanner(const SimdLevel &level = bestLevel());
+
+    size_t scan(std::string_view block);
+
+    /// @brief The offsets found by the last scan()
+    const uint32_t *index() const { return m_index.data(); }
+
+    SimdLevel level() const { return m_level; }
+    void setLevel(const SimdLevel &level);
+
+    static SimdLevel bestLevel();
+    static bool supported(const SimdLevel &level);
+
+private:
+    SimdLevel m_level;
+    std::vector<uint32_t> m_index;
+};
+
+} // namespace avapi
+#endif
@@ -0,0 +1,43 @@
+#ifndef CSVSTREAMPARSER_H
+#define CSVSTREAMPARSER_H
+#include <string>
+#include <vector>
+#include "avapi/CsvTokenizer.hpp"
+#include "avapi/Container/TimeSeries.hpp"
+
+namespace avapi {
+
+/// @brief Incremental Alpha Vantage csv parser. Chunks are fed as they arrive
+/// and every complete row is appended to the TimeSeries right away, so only
+/// the unfinished last line of a chunk is ever buffered. A JSON body (an
+/// Alpha Vantage error or notice) is kept whole and raised by finish().
+class CsvStreamParser {
+public:
+    CsvStreamParser();
+    template <typename Bool, typename = IfBool<Bool>>
+    explicit CsvStreamParser(const Bool &crypto) : m_tokenizer(crypto)
+    {
+    }
+    explicit CsvStreamParser(const CsvProjection &projection,
+                             const TimeZone &zone = TimeZone::US_EASTERN);
+
+    void feed(const char *data, const size_t &size);
+    TimeSeries finish();
+
+    bool isJson() { return m_json; }
+    const std::string &jsonBody() { return m_body; }
+
+private:
+    void parseLine(const char *begin, const char *end);
+
+    CsvTokenizer m_tokenizer;
+    bool m_started = false;
+    bool m_json = false;
+
+    std::string m_partial;
+    std::string m_body;
+    TimeSeries m_series;
+};
+
+} // namespace avapi
+#endif
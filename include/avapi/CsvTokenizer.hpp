@@ -0,0 +1,93 @@
+#ifndef CSVTOKENIZER_H
+#define CSVTOKENIZER_H
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "avapi/CsvProjection.hpp"
+#include "avapi/CsvScanner.hpp"
+#include "avapi/TimestampParser.hpp"
+#include "avapi/Container/FixedTimeSeries.hpp"
+#include "avapi/Container/Series.hpp"
+#include "avapi/Container/TimeSeries.hpp"
+
+namespace avapi {
+
+/// @brief Single pass tokenizer for Alpha Vantage csv series. Cells are
+/// viewed in place as std::string_view, numbers are read with
+/// std::from_chars and every row is written straight into the TimeSeries,
+/// so no per cell strings are ever allocated. Cell boundaries come from the
+/// structural index of a CsvScanner, built 64 KB at a time, and the cells
+/// a CsvProjection leaves out are skipped unread. Alpha Vantage
+/// csv is never quoted, which is what makes this shortcut safe. Timestamps
+/// are read as US/Eastern, or as UTC for cryptocurrency data.
+class CsvTokenizer {
+public:
+    CsvTokenizer();
+    // crypto keeps CsvProjection::crypto() and reads timestamps as UTC
+    template <typename Bool, typename = IfBool<Bool>>
+    explicit CsvTokenizer(const Bool &crypto)
+        : CsvTokenizer(crypto ? CsvProjection::crypto() : CsvProjection(),
+                       crypto ? TimeZone::UTC : TimeZone::US_EASTERN)
+    {
+    }
+    explicit CsvTokenizer(const CsvProjection &projection,
+                          const TimeZone &zone = TimeZone::US_EASTERN);
+
+    TimeSeries parse(std::string_view data,
+                     std::pmr::memory_resource *resource =
+                         std::pmr::get_default_resource());
+    TimeSeries parseParallel(std::string_view data, const size_t &threads = 0);
+    FixedTimeSeries parseFixed(std::string_view data,
+                               const unsigned &decimals = 4);
+
+    // Instantiated for OHLCV, AdjustedDaily, AdjustedWeekly and CryptoOHLCV
+    template <typename Schema>
+    Series<Schema> parseSeries(std::string_view data);
+
+    // Line by line use, lines without their '\n'
+    void parseHeader(std::string_view line, TimeSeries &series);
+    void parseRow(std::string_view line, TimeSeries &series);
+    bool headerDone() { return m_headerDone; }
+
+    // Single line access, once the header is done
+    void parseRow(std::string_view line, TimePair &row);
+    std::time_t parseTimestamp(std::string_view line);
+    double parseValue(std::string_view line, const size_t &index);
+
+    void setTimeZone(const TimeZone &zone) { m_timestamps.setTimeZone(zone); }
+    void setSimdLevel(const SimdLevel &level) { m_scanner.setLevel(level); }
+
+    static bool isJson(std::string_view data);
+    static size_t countLines(std::string_view data);
+
+private:
+    size_t skipHeader(std::string_view data, TimeSeries &series);
+    void parseBody(std::string_view body, TimeSeries &series);
+    template <typename Visit>
+    void scanBody(std::string_view body, Visit &&visit);
+    template <typename Visit>
+    void scanBlock(std::string_view block, Visit &&visit);
+    void parseFields(std::string_view line, const uint32_t *commas,
+                     const size_t &count, const size_t &offset,
+                     TimePair &row);
+    static double toDouble(std::string_view cell);
+    static void readCell(double &field, std::string_view cell);
+    static void readCell(int64_t &field, std::string_view cell);
+    template <typename Schema, size_t... I>
+    static void readFields(typename Schema::Row &row,
+                           const std::string_view *cells,
+                           std::index_sequence<I...>);
+
+    CsvProjection m_projection;
+    bool m_headerDone = false;
+    std::vector<bool> m_keep;
+    size_t m_kept = 0;
+    size_t m_last = 0;
+    std::vector<size_t> m_columns;
+    TimestampParser m_timestamps;
+    CsvScanner m_scanner;
+};
+
+} // namespace avapi
+#endif
@@ -0,0 +1,77 @@
+#ifndef CURLSESSION_H
+#define CURLSESSION_H
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace avapi {
+
+/// @brief Connection reuse counters for the shared CurlSession
+struct ConnectionStats {
+    size_t requests = 0;
+    size_t new_connections = 0;
+    size_t reused_connections = 0;
+};
+
+/// @brief Process wide libcurl transport. Performs curl_global_init() once and
+/// keeps a pool of easy handles alive between requests so their connection
+/// cache (TCP, TLS session and DNS) is reused across ApiCall instances.
+class CurlSession {
+public:
+    static CurlSession &instance();
+    ~CurlSession();
+
+    CurlSession(const CurlSession &) = delete;
+    CurlSession &operator=(const CurlSession &) = delete;
+
+    std::string perform(const std::string &url);
+
+    /// @brief (chunk, chunk size) as delivered by libcurl
+    typedef std::function<void(const char *, size_t)> ChunkCallback;
+    void perform(const std::string &url, const ChunkCallback &on_chunk);
+
+    /// @brief (index into urls, response body, error message or "")
+    typedef std::function<void(size_t, const std::string &,
+                               const std::string &)>
+        MultiCallback;
+    /// @brief (index into urls) -> whether that transfer may start now
+    typedef std::function<bool(size_t)> AdmitCallback;
+    void performMulti(const std::vector<std::string> &urls,
+                      const size_t &max_concurrent,
+                      const MultiCallback &on_complete,
+                      const AdmitCallback &admit = nullptr);
+
+    ConnectionStats stats() const;
+    void resetStats();
+
+private:
+    CurlSession();
+
+    // CURLOPT_WRITEDATA of a streaming perform()
+    struct ChunkSink {
+        const ChunkCallback *on_chunk;
+        std::exception_ptr error;
+    };
+
+    void *acquireHandle();
+    void releaseHandle(void *handle);
+    void recordTransfer(void *handle, const bool &ok);
+    static size_t WriteMemoryCallback(void *ptr, size_t size, size_t nmemb,
+                                      void *data);
+    static size_t WriteChunkCallback(void *ptr, size_t size, size_t nmemb,
+                                     void *data);
+
+    std::mutex m_mutex;
+    std::vector<void *> m_idle;
+    static const size_t m_maxIdle;
+
+    std::atomic<size_t> m_requests{0};
+    std::atomic<size_t> m_newConnections{0};
+    std::atomic<size_t> m_reusedConnections{0};
+};
+
+} // namespace avapi
+#endif
@@ -0,0 +1,29 @@
+// Single pass parsers for Alpha Vantage JSON responses
+#ifndef JSONSAX_H
+#define JSONSAX_H
+#include <ctime>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "avapi/Container/AnnualEarnings.hpp"
+#include "avapi/Container/ExchangeRate.hpp"
+#include "avapi/Container/QuarterlyEarnings.hpp"
+
+namespace avapi {
+
+// Each parser walks the body once with nlohmann::json::sax_parse() and
+// moves the values straight into its destination, no DOM is ever built.
+// Malformed JSON throws nlohmann::json::exception.
+
+void parseEarnings(std::string_view data, AnnualEarnings &annual,
+                   QuarterlyEarnings &quarterly);
+void parseOverview(std::string_view data,
+                   std::unordered_map<std::string, std::string> &fields);
+void parseHealthIndex(std::string_view data, std::vector<std::string> &fields,
+                      std::time_t &timestamp);
+ExchangeRate parseExchangeRate(std::string_view data, const std::string &from,
+                               const std::string &to);
+
+} // namespace avapi
+#endif
@@ -0,0 +1,36 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+#include <string>
+#include <string_view>
+
+namespace avapi {
+
+/// @brief Read-only memory mapping of a whole file. The contents are viewed
+/// straight from the page cache, nothing is copied into a buffer, and the
+/// kernel is told the mapping will be read sequentially so it reads ahead
+/// aggressively.
+class MappedFile {
+public:
+    explicit MappedFile(const std::string &path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    std::string_view view() const { return {m_data, m_size}; }
+    size_t size() const { return m_size; }
+
+private:
+    const char *m_data = nullptr;
+    size_t m_size = 0;
+
+#ifdef _WIN32
+    void *m_file = nullptr;
+    void *m_mapping = nullptr;
+#else
+    int m_fd = -1;
+#endif
+};
+
+} // namespace avapi
+#endif
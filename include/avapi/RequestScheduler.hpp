@@ -0,0 +1,82 @@
+#ifndef REQUESTSCHEDULER_H
+#define REQUESTSCHEDULER_H
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <vector>
+
+namespace avapi {
+
+/// @brief Request priority, lower values are served first
+enum class Priority { LIVE = 0, NORMAL, BACKFILL };
+
+/// @brief Counters for the shared RequestScheduler
+struct SchedulerStats {
+    size_t granted = 0;
+    size_t throttled = 0;
+};
+
+/// @brief Process wide token bucket that every ApiCall request passes
+/// through. Waiting requests are served by Priority, then in arrival order.
+/// In-band throttle responses from Alpha Vantage halve the effective rate and
+/// pause the bucket; successful responses slowly restore it.
+class RequestScheduler {
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    static RequestScheduler &instance();
+
+    RequestScheduler(const RequestScheduler &) = delete;
+    RequestScheduler &operator=(const RequestScheduler &) = delete;
+
+    // A calls_per_minute of 0 disables rate limiting
+    void setRate(const double &calls_per_minute, const size_t &burst);
+    void setCooldown(const std::chrono::milliseconds &cooldown);
+    void setMaxRetries(const size_t &retries);
+    size_t maxRetries();
+
+    void acquire(const Priority &priority);
+    bool tryAcquire(const Priority &priority);
+    Clock::duration timeUntilToken();
+
+    void onSuccess();
+    void onThrottled();
+    static bool isThrottled(const std::string &data);
+
+    SchedulerStats stats();
+
+private:
+    RequestScheduler();
+
+    struct Ticket {
+        Priority priority;
+        size_t sequence;
+    };
+    struct TicketOrder {
+        bool operator()(const Ticket &a, const Ticket &b) const;
+    };
+
+    void refill(const Clock::time_point &now);
+    Clock::time_point nextTokenTime(const Clock::time_point &now);
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::priority_queue<Ticket, std::vector<Ticket>, TicketOrder> m_waiting;
+    size_t m_nextSequence = 0;
+
+    double m_ratePerSecond;
+    double m_capacity;
+    double m_tokens;
+    double m_factor = 1.0;
+    Clock::time_point m_lastRefill;
+    Clock::time_point m_pausedUntil;
+    std::chrono::milliseconds m_cooldown;
+    size_t m_maxRetries;
+
+    SchedulerStats m_stats;
+};
+
+} // namespace avapi
+#endif
@@ -0,0 +1,65 @@
+#ifndef RESPONSECACHE_H
+#define RESPONSECACHE_H
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace avapi {
+
+/// @brief Counters for the shared ResponseCache
+struct CacheStats {
+    size_t hits = 0;
+    size_t misses = 0;
+    size_t stores = 0;
+    size_t evictions = 0;
+};
+
+/// @brief Process wide on-disk cache of Alpha Vantage responses, keyed by the
+/// canonical query (Url::canonicalQuery(), no API key) and the name of the
+/// Transport it was sent through (ApiCall::cacheKey()). Entries expire after
+/// a per FUNCTION time to live; a TTL of zero means that FUNCTION is never
+/// cached. Disabled until a directory is set.
+class ResponseCache {
+public:
+    static ResponseCache &instance();
+
+    ResponseCache(const ResponseCache &) = delete;
+    ResponseCache &operator=(const ResponseCache &) = delete;
+
+    // An empty path disables the cache
+    void setDirectory(const std::string &path);
+    bool enabled();
+
+    void setMaxBytes(const std::uintmax_t &bytes);
+    void setTtl(const std::string &function, const std::chrono::seconds &ttl);
+    std::chrono::seconds ttl(const std::string &function);
+
+    bool get(const std::string &key, const std::string &function,
+             std::string &data);
+    void put(const std::string &key, const std::string &function,
+             const std::string &data);
+    void clear();
+    static bool isCacheable(const std::string &data);
+
+    CacheStats stats();
+
+private:
+    ResponseCache();
+
+    std::string entryPath(const std::string &key);
+    void evict();
+
+    std::mutex m_mutex;
+    std::string m_directory;
+    std::uintmax_t m_maxBytes;
+    std::uintmax_t m_totalBytes = 0;
+    std::unordered_map<std::string, std::chrono::seconds> m_ttl;
+    size_t m_tempCounter = 0;
+
+    CacheStats m_stats;
+};
+
+} // namespace avapi
+#endif
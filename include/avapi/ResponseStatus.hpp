@@ -0,0 +1,47 @@
+#ifndef RESPONSESTATUS_H
+#define RESPONSESTATUS_H
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace avapi {
+
+/// @brief What kind of Alpha Vantage error a response is, if any
+enum class ApiError {
+    NONE = 0,     // csv, or a JSON payload
+    EMPTY,        // nothing but whitespace
+    EMPTY_OBJECT, // "{}", e.g. an unknown symbol
+    INVALID_CALL, // "Error Message"
+    RATE_LIMITED, // "Note", or "Information" about the call frequency
+    INFORMATION   // any other "Information", e.g. a premium endpoint
+};
+
+/// @brief Outcome of classifyResponse()
+struct ResponseStatus {
+    ApiError error = ApiError::NONE;
+    bool json = false;
+
+    // Alpha Vantage's own text, empty unless error is set
+    std::string message;
+
+    bool ok() const { return error == ApiError::NONE; }
+};
+
+/// @brief Thrown where an error response cannot be returned as a value
+class ResponseError : public std::runtime_error {
+public:
+    ResponseError(const ResponseStatus &status, const std::string &what)
+        : std::runtime_error(what), m_status(status)
+    {
+    }
+
+    const ResponseStatus &status() const { return m_status; }
+
+private:
+    ResponseStatus m_status;
+};
+
+ResponseStatus classifyResponse(std::string_view data);
+
+} // namespace avapi
+#endif
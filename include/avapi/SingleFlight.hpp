@@ -0,0 +1,104 @@
+#ifndef SINGLEFLIGHT_H
+#define SINGLEFLIGHT_H
+#include <exception>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace avapi {
+
+/// @brief Counters for request deduplication
+struct FlightStats {
+    size_t fetches = 0;
+    size_t coalesced = 0;
+};
+
+/// @brief Collapses concurrent calls for the same key into one. The first
+/// caller runs the fetch, callers arriving while it is in flight wait for it
+/// and receive a copy of its result, or its exception. Nothing is kept once
+/// the fetch completes, later calls fetch again.
+template <typename T> class SingleFlight {
+public:
+    SingleFlight() {}
+
+    SingleFlight(const SingleFlight &) = delete;
+    SingleFlight &operator=(const SingleFlight &) = delete;
+
+    /// @brief Run fetch for key, or join the identical fetch in flight. The
+    /// leader returns its own result, moved rather than copied, and only
+    /// copies it into the shared result when other callers joined.
+    /// @param key: Identifies identical requests
+    /// @param fetch: Produces the result, may throw
+    T run(const std::string &key, const std::function<T()> &fetch)
+    {
+        std::promise<T> promise;
+        std::shared_future<T> result;
+        bool leader = false;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_inFlight.find(key);
+            if (it != m_inFlight.end()) {
+                ++m_stats.coalesced;
+                ++it->second.joined;
+                result = it->second.result;
+            }
+            else {
+                ++m_stats.fetches;
+                leader = true;
+                m_inFlight.emplace(key,
+                                   Flight{promise.get_future().share(), 0});
+            }
+        }
+
+        // Joined an existing flight
+        if (!leader)
+            return result.get();
+
+        try {
+            T value = fetch();
+            if (land(key))
+                promise.set_value(value);
+            return value;
+        }
+        catch (...) {
+            if (land(key))
+                promise.set_exception(std::current_exception());
+            throw;
+        }
+    }
+
+    /// @brief Get a snapshot of the counters
+    FlightStats stats()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_stats;
+    }
+
+private:
+    struct Flight {
+        std::shared_future<T> result;
+        size_t joined;
+    };
+
+    /// @brief End the flight of key, later calls fetch again
+    /// @returns Whether any caller joined the flight
+    bool land(const std::string &key)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_inFlight.find(key);
+        if (it == m_inFlight.end())
+            return false;
+        bool joined = it->second.joined > 0;
+        m_inFlight.erase(it);
+        return joined;
+    }
+
+    std::mutex m_mutex;
+    std::unordered_map<std::string, Flight> m_inFlight;
+    FlightStats m_stats;
+};
+
+} // namespace avapi
+#endif
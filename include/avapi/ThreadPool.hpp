@@ -0,0 +1,81 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+#include "avapi/RequestScheduler.hpp"
+
+namespace avapi {
+
+/// @brief Fixed size pool of worker threads running queued tasks by
+/// Priority, then in FIFO order. ThreadPool::io() is the shared background
+/// loop behind the *Async() fetch methods, so a LIVE request queued behind
+/// BACKFILL ones gets the next free worker. ThreadPool::cpu() runs parsing
+/// work split across cores.
+class ThreadPool {
+public:
+    explicit ThreadPool(const size_t &threads);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    static ThreadPool &io();
+    static ThreadPool &cpu();
+    size_t size() { return m_workers.size(); }
+
+    /// @brief Queue a callable, its result (or exception) is delivered
+    /// through the returned std::future
+    /// @param task: The callable
+    /// @param priority: Tasks of a lower Priority value start first
+    /// (default = NORMAL)
+    template <typename F>
+    auto submit(F &&task, const Priority &priority = Priority::NORMAL)
+        -> std::future<decltype(task())>
+    {
+        typedef decltype(task()) Result;
+        auto packaged = std::make_shared<std::packaged_task<Result()>>(
+            std::forward<F>(task));
+        std::future<Result> result = packaged->get_future();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_tasks.push(
+                {priority, m_queued++, [packaged]() { (*packaged)(); }});
+        }
+        m_cv.notify_one();
+        return result;
+    }
+
+private:
+    struct Task {
+        Priority priority;
+        uint64_t order;
+        std::function<void()> run;
+
+        // std::priority_queue pops the greatest, here the most urgent
+        bool operator<(const Task &other) const
+        {
+            if (priority != other.priority)
+                return priority > other.priority;
+            return order > other.order;
+        }
+    };
+
+    void run();
+
+    std::vector<std::thread> m_workers;
+    std::priority_queue<Task> m_tasks;
+    uint64_t m_queued = 0;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    bool m_stop = false;
+};
+
+} // namespace avapi
+#endif
@@ -0,0 +1,46 @@
+#ifndef TIMESTAMPPARSER_H
+#define TIMESTAMPPARSER_H
+#include <cstdint>
+#include <ctime>
+#include <string_view>
+
+namespace avapi {
+
+/// @brief The timezone Alpha Vantage timestamps are read in. Stock series
+/// are US/Eastern, cryptocurrency series and exchange rates are UTC.
+enum class TimeZone { UTC = 0, US_EASTERN };
+
+/// @brief Allocation free parser for "YYYY-MM-DD[ HH:MM[:SS]]" timestamps.
+/// Dates are converted arithmetically (no locale or timezone database), and
+/// the last date seen is remembered, so consecutive intraday rows of the same
+/// day only parse their time of day.
+class TimestampParser {
+public:
+    explicit TimestampParser(const TimeZone &zone = TimeZone::US_EASTERN);
+
+    std::time_t parse(std::string_view input);
+
+    void setTimeZone(const TimeZone &zone) { m_zone = zone; }
+    TimeZone timeZone() { return m_zone; }
+
+    static std::int64_t daysFromCivil(int year, unsigned month, unsigned day);
+
+private:
+    std::int64_t toUtc(const std::int64_t &local, const int &year);
+
+    TimeZone m_zone;
+
+    // Last date parsed
+    char m_date[10] = {};
+    bool m_cached = false;
+    int m_year = 0;
+    std::int64_t m_days = 0;
+
+    // US/Eastern daylight saving time of m_dstYear, in local seconds
+    int m_dstYear = 0;
+    std::int64_t m_dstStart = 0;
+    std::int64_t m_dstEnd = 0;
+};
+
+} // namespace avapi
+#endif
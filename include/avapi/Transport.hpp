@@ -0,0 +1,75 @@
+#ifndef TRANSPORT_H
+#define TRANSPORT_H
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "avapi/CurlSession.hpp"
+
+namespace avapi {
+
+/// @brief How an ApiCall turns a query url into a response body. The default
+/// is a CurlTransport; every ApiCall and BatchFetch starts out with
+/// Transport::defaultTransport() and may be given its own.
+class Transport {
+public:
+    typedef CurlSession::ChunkCallback ChunkCallback;
+    typedef CurlSession::MultiCallback MultiCallback;
+    typedef CurlSession::AdmitCallback AdmitCallback;
+
+    virtual ~Transport() {}
+
+    virtual std::string get(const std::string &url) = 0;
+    virtual void get(const std::string &url, const ChunkCallback &on_chunk);
+    virtual void getMany(const std::vector<std::string> &urls,
+                         const size_t &max_concurrent,
+                         const MultiCallback &on_complete,
+                         const AdmitCallback &admit = nullptr);
+
+    // Whether requests count against the Alpha Vantage quota
+    virtual bool isRateLimited() { return true; }
+
+    // Kept in ResponseCache keys, e.g. "curl" or "file:<directory>"
+    virtual std::string name();
+
+    static std::shared_ptr<Transport> defaultTransport();
+    static void
+    setDefaultTransport(const std::shared_ptr<Transport> &transport);
+};
+
+/// @brief Live Alpha Vantage requests through the shared CurlSession
+class CurlTransport : public Transport {
+public:
+    std::string get(const std::string &url) override;
+    void get(const std::string &url, const ChunkCallback &on_chunk) override;
+    void getMany(const std::vector<std::string> &urls,
+                 const size_t &max_concurrent, const MultiCallback &on_complete,
+                 const AdmitCallback &admit = nullptr) override;
+    std::string name() override;
+};
+
+/// @brief Offline transport serving captured responses from a directory.
+/// A query maps to a file registered with map(), otherwise to
+/// "<FUNCTION>_<SYMBOL>[_<interval>][_<market>].<datatype>", e.g.
+/// "TIME_SERIES_DAILY_GME.csv" or "DIGITAL_CURRENCY_DAILY_BTC_USD.csv".
+class FileTransport : public Transport {
+public:
+    explicit FileTransport(const std::string &directory);
+
+    std::string directory;
+
+    void map(const std::string &url, const std::string &file);
+    std::string filePath(const std::string &url);
+    static std::string key(const std::string &url);
+
+    std::string get(const std::string &url) override;
+    void get(const std::string &url, const ChunkCallback &on_chunk) override;
+    bool isRateLimited() override { return false; }
+    std::string name() override;
+
+private:
+    std::unordered_map<std::string, std::string> m_files;
+};
+
+} // namespace avapi
+#endif
@@ -1,5 +1,6 @@
 #ifndef COMPANYEARNINGS_H
 #define COMPANYEARNINGS_H
+#include <future>
 #include <string>
 #include "avapi/ApiCall.hpp"
 #include "avapi/Container/AnnualEarnings.hpp"
@@ -18,6 +19,7 @@ public:
     AnnualEarnings annual() { return annual_earnings; }
     QuarterlyEarnings quarterly() { return quarterly_earnings; };
     void update();
+    std::future<void> updateAsync();
 
 private:
     AnnualEarnings annual_earnings;
@@ -1,5 +1,6 @@
 #ifndef COMPANYOVERVIEW_H
 #define COMPANYOVERVIEW_H
+#include <future>
 #include <string>
 #include <unordered_map>
 #include "avapi/ApiCall.hpp"
@@ -17,6 +18,7 @@ public:
     const std::string &get(const std::string &field);
     std::string operator[](const std::string &field) { return data[field]; }
     void update();
+    std::future<void> updateAsync();
 
 private:
     std::unordered_map<std::string, std::string> data;
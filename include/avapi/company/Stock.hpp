@@ -1,5 +1,6 @@
 #ifndef STOCK_H
 #define STOCK_H
+#include <future>
 #include <string>
 #include <vector>
 #include "avapi/ApiCall.hpp"
@@ -17,10 +18,33 @@ public:
     std::string symbol;
 
     TimeSeries getTimeSeries(const SeriesType &type, const bool &adjusted,
-                             const std::string &interval = "30min");
+                             const std::string &interval = "30min",
+                             const CsvProjection &columns = CsvProjection());
     GlobalQuote getGlobalQuote();
 
+    // Bring a previously fetched TimeSeries up to date
+    void refreshTimeSeries(TimeSeries &series,
+                           const std::string &interval = "30min");
+
+    // Non-blocking variants, run on avapi::ThreadPool::io()
+    std::future<TimeSeries>
+    getTimeSeriesAsync(const SeriesType &type, const bool &adjusted,
+                       const std::string &interval = "30min",
+                       const CsvProjection &columns = CsvProjection());
+    std::future<GlobalQuote> getGlobalQuoteAsync();
+
+    // getTimeSeries() split into its query and parse halves
+    std::string timeSeriesQuery(const SeriesType &type, const bool &adjusted,
+                                const std::string &interval = "30min");
+    TimeSeries
+    timeSeriesFromCsv(const std::string &csv, const SeriesType &type,
+                      const bool &adjusted,
+                      const std::string &interval = "30min",
+                      const CsvProjection &columns = CsvProjection());
+
 private:
+    void labelTimeSeries(TimeSeries &series, const SeriesType &type,
+                         const bool &adjusted, const std::string &interval);
     static const std::vector<std::string> series_function;
 };
 } // namespace avapi
@@ -1,5 +1,6 @@
 #ifndef HEALTHINDEX_H
 #define HEALTHINDEX_H
+#include <future>
 #include <string>
 #include <vector>
 #include "avapi/ApiCall.hpp"
@@ -18,6 +19,7 @@ public:
     /// maturity score, utility score, timezone]
     std::vector<std::string> data;
     void update();
+    std::future<void> updateAsync();
     void printData();
 };
 
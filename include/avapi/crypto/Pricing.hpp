@@ -1,5 +1,6 @@
 #ifndef CRYPTOPRICING_H
 #define CRYPTOPRICING_H
+#include <future>
 #include <string>
 #include <vector>
 #include "avapi/ApiCall.hpp"
@@ -16,11 +17,33 @@ public:
 
     std::string symbol;
 
-    TimeSeries getTimeSeries(const SeriesType &type,
-                             const std::string &market = "USD");
+    TimeSeries
+    getTimeSeries(const SeriesType &type, const std::string &market = "USD",
+                  const CsvProjection &columns = CsvProjection::crypto());
     ExchangeRate exchange(const std::string &market = "USD");
 
+    // Bring a previously fetched TimeSeries up to date
+    void refreshTimeSeries(TimeSeries &series);
+
+    // Non-blocking variants, run on avapi::ThreadPool::io()
+    std::future<TimeSeries>
+    getTimeSeriesAsync(const SeriesType &type,
+                       const std::string &market = "USD",
+                       const CsvProjection &columns = CsvProjection::crypto());
+    std::future<ExchangeRate> exchangeAsync(const std::string &market = "USD");
+
+    // getTimeSeries() split into its query and parse halves
+    std::string timeSeriesQuery(const SeriesType &type,
+                                const std::string &market = "USD");
+    TimeSeries
+    timeSeriesFromCsv(const std::string &csv, const SeriesType &type,
+                      const std::string &market = "USD",
+                      const CsvProjection &columns = CsvProjection::crypto());
+
 private:
+    void labelTimeSeries(TimeSeries &series, const SeriesType &type,
+                         const std::string &market);
+    static SeriesType checkType(const SeriesType &type);
     static const std::vector<std::string> series_function;
 };
 
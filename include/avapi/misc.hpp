@@ -2,7 +2,12 @@
 #ifndef AVAPIMISC_H
 #define AVAPIMISC_H
 #include <string>
+#include <string_view>
 #include <iomanip>
+#include "avapi/CsvProjection.hpp"
+#include "avapi/TimestampParser.hpp"
+#include "avapi/Container/FixedTimeSeries.hpp"
+#include "avapi/Container/Series.hpp"
 #include "avapi/Container/TimeSeries.hpp"
 
 namespace avapi {
@@ -12,12 +17,60 @@ bool stringReplace(std::string &str, const std::string &from,
 
 std::string readApiKey(const std::string &file_path);
 
-std::time_t toUnixTimestamp(const std::string &input);
+std::time_t toUnixTimestamp(std::string_view input,
+                            const TimeZone &zone = TimeZone::US_EASTERN);
 bool isJsonString(const std::string &data);
+std::string normalizeHeader(const std::string &header);
 
-TimeSeries parseCsvString(const std::string &data, const bool &crypto = false);
+TimeSeries parseCsvString(const std::string &data);
+TimeSeries parseCsvString(const std::string &data,
+                          const CsvProjection &projection,
+                          const TimeZone &zone = TimeZone::US_EASTERN);
+TimeSeries parseCsvFile(const std::string &file_path);
 TimeSeries parseCsvFile(const std::string &file_path,
+                        const CsvProjection &projection,
+                        const TimeZone &zone = TimeZone::US_EASTERN);
+
+/// @brief Returns a TimeSeries created from a csv std::string
+/// @param data: An csv std::string object
+/// @param crypto: Whether the csv data is from a cryptocurrency
+template <typename Bool, typename = IfBool<Bool>>
+TimeSeries parseCsvString(const std::string &data, const Bool &crypto)
+{
+    if (crypto)
+        return parseCsvString(data, CsvProjection::crypto(), TimeZone::UTC);
+    return parseCsvString(data);
+}
+
+/// @brief Returns a TimeSeries created from a csv file
+/// @param file_path: The csv file's path
+/// @param crypto: Whether the csv data is from a cryptocurrency
+template <typename Bool, typename = IfBool<Bool>>
+TimeSeries parseCsvFile(const std::string &file_path, const Bool &crypto)
+{
+    if (crypto)
+        return parseCsvFile(file_path, CsvProjection::crypto(), TimeZone::UTC);
+    return parseCsvFile(file_path);
+}
+// Columns drawn from resource, e.g. one arena for a whole universe
+TimeSeries parseCsvString(const std::string &data,
+                          std::pmr::memory_resource *resource,
+                          const bool &crypto = false);
+TimeSeries parseCsvFile(const std::string &file_path,
+                        std::pmr::memory_resource *resource,
                         const bool &crypto = false);
+// Schema typed parsing, e.g. parseCsvFile<avapi::OHLCV>("daily.csv")
+template <typename Schema>
+Series<Schema> parseCsvString(const std::string &data);
+template <typename Schema>
+Series<Schema> parseCsvFile(const std::string &file_path);
+FixedTimeSeries parseCsvStringFixed(const std::string &data,
+                                   const bool &crypto = false);
+FixedTimeSeries parseCsvFileFixed(const std::string &file_path,
+                                  const bool &crypto = false);
+TimeSeries parseCsvFileParallel(const std::string &file_path,
+                                const bool &crypto = false,
+                                const size_t &threads = 0);
 
 } // namespace avapi
 
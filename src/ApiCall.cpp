@@ -1,7 +1,10 @@
+#include <algorithm>
+#include <cstdint>
 #include <iostream>
 #include <stdexcept>
-#include <curl/curl.h>
+#include "avapi/misc.hpp"
 #include "avapi/ApiCall.hpp"
+#include "avapi/CsvStreamParser.hpp"
 
 namespace avapi {
 
@@ -49,6 +52,25 @@ std::string Url::buildQuery()
     return url;
 }
 
+/// @brief Construct the url query without its API key and with fields in
+/// Url::Field order, so identical requests share one key
+/// @returns A canonical Alpha Vantage API query URL
+std::string Url::canonicalQuery()
+{
+    Query sorted = m_query;
+    std::sort(sorted.begin(), sorted.end(),
+              [](const FieldValue &a, const FieldValue &b) {
+                  return a.field < b.field;
+              });
+
+    std::string url = m_urlBase;
+    for (auto &param : sorted) {
+        if (param.field != Field::API_KEY)
+            url += m_fieldStrings[static_cast<int>(param.field)] + param.value;
+    }
+    return url;
+}
+
 /// @brief Vector of query field strings
 const std::vector<std::string> Url::m_fieldStrings{
     "&function=",   "&symbol=",   "&interval=",      "&adjusted=",
@@ -58,8 +80,14 @@ const std::vector<std::string> Url::m_fieldStrings{
 /// @brief Alpha Vantage base url
 const std::string Url::m_urlBase{"https://www.alphavantage.co/query?"};
 
+/// @brief In-flight requests shared by every ApiCall, keyed by flightKey()
+SingleFlight<std::string> ApiCall::m_bodyFlights;
+SingleFlight<TimeSeries> ApiCall::m_seriesFlights;
+
 /// @brief   ApiCall Class default constructor
-ApiCall::ApiCall() : api_key("")
+ApiCall::ApiCall()
+    : api_key(""), priority(Priority::NORMAL), streaming(false),
+      transport(Transport::defaultTransport())
 {
     url = new avapi::Url();
     url->setFieldValue(Url::Field::API_KEY, api_key);
@@ -67,7 +95,9 @@ ApiCall::ApiCall() : api_key("")
 
 /// @brief   ApiCall Class constructor
 /// @param   key The Alpha Vantage API key to set
-ApiCall::ApiCall(const std::string &key) : api_key(key)
+ApiCall::ApiCall(const std::string &key)
+    : api_key(key), priority(Priority::NORMAL), streaming(false),
+      transport(Transport::defaultTransport())
 {
     url = new avapi::Url();
     url->setFieldValue(Url::Field::API_KEY, api_key);
@@ -107,34 +137,202 @@ std::string ApiCall::getValue(const Url::Field &field)
     return url->getValue(field);
 }
 
-/// @brief   Curls url
-/// @param   url The API query URL to be curled
+/// @brief   Build the API url query without curling it
+/// @returns An Alpha Vantage API query URL
+std::string ApiCall::buildQuery() { return url->buildQuery(); }
+
+/// @brief   Get the avapi::ResponseCache key of the current query
+/// @returns The canonical query, without the API key, followed by the
+/// Transport::name() it is sent through
+std::string ApiCall::cacheKey()
+{
+    return url->canonicalQuery() + "#" + transport->name();
+}
+
+/// @brief   Get the avapi::SingleFlight key of the current query. Requests
+/// only share a flight when they also share the API key and the Transport
+/// instance, so one key's quota or error never answers another's request.
+/// @returns cacheKey(), the API key and the transport's address
+std::string ApiCall::flightKey()
+{
+    return cacheKey() + "#" + api_key + "#" +
+           std::to_string(reinterpret_cast<std::uintptr_t>(transport.get()));
+}
+
+/// @brief   Curls url at this ApiCall's priority
 /// @returns The data as an std::string
-std::string ApiCall::curlQuery()
+std::string ApiCall::curlQuery() { return curlQuery(priority); }
+
+/// @brief   Curls url, joining an identical request already in flight from
+/// any ApiCall instead of sending it again. Error responses are returned
+/// as they are, see lastStatus().
+/// @param   priority The avapi::Priority to schedule this request with
+/// @returns The data as an std::string
+std::string ApiCall::curlQuery(const Priority &priority)
+{
+    std::string data =
+        m_bodyFlights.run(flightKey(), [&]() { return fetch(priority); });
+    m_status = classifyResponse(data);
+    return data;
+}
+
+/// @brief   Requests a csv url and parses it into a TimeSeries, sharing the
+/// parsed result of an identical request already in flight
+/// @returns The parsed TimeSeries (without symbol, type or title set)
+TimeSeries ApiCall::curlQueryCsv() { return curlQueryCsv(CsvProjection()); }
+
+/// @brief   Requests a csv url and parses the selected columns into a
+/// TimeSeries, sharing the parsed result of an identical request with the
+/// same projection already in flight. Error responses throw an
+/// avapi::ResponseError, their status is also kept in lastStatus().
+/// @param   projection The columns to keep
+/// @param   zone The time zone of the timestamps (default = US_EASTERN)
+/// @returns The parsed TimeSeries (without symbol, type or title set)
+TimeSeries ApiCall::curlQueryCsv(const CsvProjection &projection,
+                                 const TimeZone &zone)
+{
+    std::string key = flightKey() + "#" + projection.key() + "#" +
+                      std::to_string(static_cast<int>(zone));
+    try {
+        TimeSeries series = m_seriesFlights.run(
+            key, [&]() { return fetchCsv(projection, zone); });
+        m_status = ResponseStatus();
+        return series;
+    }
+    catch (const ResponseError &error) {
+        m_status = error.status();
+        throw;
+    }
+}
+
+/// @brief   Get the request deduplication counters shared by all ApiCalls
+/// @returns An avapi::FlightStats snapshot
+FlightStats ApiCall::flightStats()
+{
+    FlightStats bodies = m_bodyFlights.stats();
+    FlightStats series = m_seriesFlights.stats();
+
+    FlightStats stats;
+    stats.fetches = bodies.fetches + series.fetches;
+    stats.coalesced = bodies.coalesced + series.coalesced;
+    return stats;
+}
+
+/// @brief   Sends url through this ApiCall's avapi::Transport once the
+/// avapi::RequestScheduler allows it. Throttle responses are retried up to
+/// RequestScheduler::maxRetries() times. Transports that are not rate limited
+/// bypass the scheduler. Fresh responses are served from, and new ones stored
+/// in, the avapi::ResponseCache.
+/// @param   priority The avapi::Priority to schedule this request with
+/// @returns The data as an std::string
+std::string ApiCall::fetch(const Priority &priority)
 {
     if (api_key == "") {
         throw std::exception(
             "\"avapi/ApiCall.cpp\": Alpha Vantage API key not present.");
     }
 
-    CURL *curl;
-    int res;
+    ResponseCache &cache = ResponseCache::instance();
+    std::string key = cacheKey();
+    std::string function = url->getValue(Url::Field::FUNCTION);
     std::string data;
 
-    curl = curl_easy_init();
-    if (curl) {
-        curl_easy_setopt(curl, CURLOPT_URL, url->buildQuery().c_str());
-        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteMemoryCallback);
-        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &data);
-        res = curl_easy_perform(curl);
+    if (cache.get(key, function, data))
+        return data;
+
+    RequestScheduler &scheduler = RequestScheduler::instance();
+    std::string query = url->buildQuery();
+    bool limited = transport->isRateLimited();
+
+    for (size_t attempt = 0;; ++attempt) {
+        if (limited)
+            scheduler.acquire(priority);
+        data = transport->get(query);
+
+        if (!limited)
+            break;
+        if (!RequestScheduler::isThrottled(data)) {
+            scheduler.onSuccess();
+            break;
+        }
 
-        /* always cleanup */
-        curl_easy_cleanup(curl);
-        curl_global_cleanup();
+        scheduler.onThrottled();
+        if (attempt >= scheduler.maxRetries())
+            break;
     }
+
+    if (ResponseCache::isCacheable(data))
+        cache.put(key, function, data);
     return data;
 }
 
+/// @brief   Fetches a csv url and parses it into a TimeSeries. With streaming
+/// set, rows are parsed by an avapi::CsvStreamParser as chunks arrive and the
+/// body is only held in memory when the avapi::ResponseCache wants it.
+/// @param   projection The columns to keep
+/// @param   zone The time zone of the timestamps
+/// @returns The parsed TimeSeries (without symbol, type or title set)
+TimeSeries ApiCall::fetchCsv(const CsvProjection &projection,
+                             const TimeZone &zone)
+{
+    if (!streaming)
+        return parseCsvString(fetch(priority), projection, zone);
+
+    if (api_key == "") {
+        throw std::runtime_error(
+            "\"avapi/ApiCall.cpp\": Alpha Vantage API key not present.");
+    }
+
+    ResponseCache &cache = ResponseCache::instance();
+    std::string key = cacheKey();
+    std::string function = url->getValue(Url::Field::FUNCTION);
+    std::string data;
+
+    if (cache.get(key, function, data))
+        return parseCsvString(data, projection, zone);
+    bool keep = cache.enabled() && cache.ttl(function).count() > 0;
+
+    RequestScheduler &scheduler = RequestScheduler::instance();
+    std::string query = url->buildQuery();
+    bool limited = transport->isRateLimited();
+
+    for (size_t attempt = 0;; ++attempt) {
+        CsvStreamParser parser(projection, zone);
+        data.clear();
+
+        if (limited)
+            scheduler.acquire(priority);
+        transport->get(query, [&](const char *chunk, size_t size) {
+            parser.feed(chunk, size);
+            if (keep)
+                data.append(chunk, size);
+        });
+
+        bool throttled =
+            parser.isJson() && RequestScheduler::isThrottled(parser.jsonBody());
+        if (!limited || !throttled || attempt >= scheduler.maxRetries()) {
+            if (limited && throttled)
+                scheduler.onThrottled();
+            else if (limited)
+                scheduler.onSuccess();
+
+            // Raises Alpha Vantage's JSON error, if that is what arrived
+            TimeSeries series = parser.finish();
+            if (keep && ResponseCache::isCacheable(data))
+                cache.put(key, function, data);
+            return series;
+        }
+        scheduler.onThrottled();
+    }
+}
+
+/// @brief   Get the connection reuse counters shared by all ApiCalls
+/// @returns An avapi::ConnectionStats snapshot
+ConnectionStats ApiCall::connectionStats()
+{
+    return CurlSession::instance().stats();
+}
+
 /// @brief   Reset the field/value queries within avapi::Url
 void ApiCall::resetQuery()
 {
@@ -145,20 +343,4 @@ void ApiCall::resetQuery()
     url->setFieldValue(Url::Field::API_KEY, api_key);
 }
 
-/// @brief   Callback function for CURLOPT_WRITEFUNCTION
-/// @param   ptr The downloaded chunk members
-/// @param   size Member memory size
-/// @param   nmemb Number of members
-/// @param   data Current running chunk for data appension
-/// @returns The current running chunk's realsize
-size_t ApiCall::WriteMemoryCallback(void *ptr, size_t size, size_t nmemb,
-                                    void *data)
-{
-    size_t realsize = size * nmemb;
-
-    std::string *mem = reinterpret_cast<std::string *>(data);
-    mem->append(static_cast<char *>(ptr), realsize);
-    return realsize;
-}
-
 } // namespace avapi
\ No newline at end of file
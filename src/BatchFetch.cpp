@@ -0,0 +1,158 @@
+#include <stdexcept>
+#include "avapi/BatchFetch.hpp"
+#include "avapi/RequestScheduler.hpp"
+#include "avapi/ResponseCache.hpp"
+#include "avapi/Company/Stock.hpp"
+#include "avapi/Crypto/Pricing.hpp"
+
+namespace avapi {
+
+/// @brief   BatchFetch default constructor
+BatchFetch::BatchFetch()
+    : api_key(""), max_concurrent(8), priority(Priority::NORMAL),
+      transport(Transport::defaultTransport()), output_size("compact")
+{
+}
+
+/// @brief   BatchFetch constructor
+/// @param   key The Alpha Vantage API key to use
+/// @param   max_concurrent Maximum number of requests in flight at once
+/// (default = 8)
+BatchFetch::BatchFetch(const std::string &key, const size_t &max_concurrent)
+    : api_key(key), max_concurrent(max_concurrent), priority(Priority::NORMAL),
+      transport(Transport::defaultTransport()), output_size("compact")
+{
+}
+
+/// @brief   Set the TimeSeries output size for every request in a batch
+/// @param   size enum class SeriesSize [COMPACT, FULL]
+void BatchFetch::setOutputSize(const SeriesSize &size)
+{
+    if (size == SeriesSize::COMPACT)
+        output_size = "compact";
+    else if (size == SeriesSize::FULL)
+        output_size = "full";
+}
+
+/// @brief   Fetch several TimeSeries concurrently. Fresh responses come from
+/// the avapi::ResponseCache, the rest are downloaded and parsed as soon as
+/// their transfer completes. A failed request only marks its own SeriesResult.
+/// @param   requests The TimeSeries to fetch
+/// @returns One SeriesResult per request, in request order
+std::vector<SeriesResult>
+BatchFetch::fetch(const std::vector<SeriesRequest> &requests)
+{
+    if (api_key == "") {
+        throw std::runtime_error(
+            "avapi/BatchFetch.cpp: Alpha Vantage API key not present.");
+    }
+
+    std::vector<SeriesResult> results(requests.size());
+    std::vector<std::string> urls(requests.size());
+    std::vector<std::string> keys(requests.size());
+    std::vector<std::string> functions(requests.size());
+
+    for (size_t i = 0; i < requests.size(); ++i) {
+        const SeriesRequest &request = requests[i];
+        results[i].request = request;
+
+        if (request.market != "") {
+            CryptoPricing pricing(request.symbol, api_key);
+            pricing.output_size = output_size;
+            pricing.transport = transport;
+            urls[i] = pricing.timeSeriesQuery(request.type, request.market);
+            keys[i] = pricing.cacheKey();
+            functions[i] = pricing.getValue(Url::Field::FUNCTION);
+        }
+        else {
+            CompanyStock stock(request.symbol, api_key);
+            stock.output_size = output_size;
+            stock.transport = transport;
+            urls[i] = stock.timeSeriesQuery(request.type, request.adjusted,
+                                            request.interval);
+            keys[i] = stock.cacheKey();
+            functions[i] = stock.getValue(Url::Field::FUNCTION);
+        }
+    }
+
+    auto parse = [&](size_t i, const std::string &body) {
+        SeriesResult &result = results[i];
+        const SeriesRequest &request = requests[i];
+        try {
+            if (request.market != "") {
+                CryptoPricing pricing(request.symbol, api_key);
+                result.series = pricing.timeSeriesFromCsv(body, request.type,
+                                                          request.market);
+            }
+            else {
+                CompanyStock stock(request.symbol, api_key);
+                result.series = stock.timeSeriesFromCsv(
+                    body, request.type, request.adjusted, request.interval);
+            }
+            result.ok = true;
+            result.error = "";
+        }
+        catch (const std::exception &ex) {
+            result.error = ex.what();
+        }
+    };
+
+    RequestScheduler &scheduler = RequestScheduler::instance();
+    ResponseCache &cache = ResponseCache::instance();
+    size_t max_retries = scheduler.maxRetries();
+
+    // Indices into requests still to be fetched, throttled ones go again
+    std::vector<size_t> pending;
+    for (size_t i = 0; i < requests.size(); ++i) {
+        std::string body;
+        if (cache.get(keys[i], functions[i], body))
+            parse(i, body);
+        else
+            pending.push_back(i);
+    }
+
+    for (size_t attempt = 0; attempt <= max_retries && !pending.empty();
+         ++attempt) {
+        std::vector<std::string> pending_urls;
+        for (auto i : pending)
+            pending_urls.push_back(urls[i]);
+
+        std::vector<size_t> throttled;
+        auto on_complete = [&](size_t n, const std::string &body,
+                               const std::string &error) {
+            size_t i = pending[n];
+            SeriesResult &result = results[i];
+
+            if (error != "") {
+                result.error = error;
+                return;
+            }
+
+            if (RequestScheduler::isThrottled(body)) {
+                scheduler.onThrottled();
+                throttled.push_back(i);
+                result.error = "avapi/BatchFetch.cpp: 'BatchFetch::fetch': "
+                               "Alpha Vantage rate limit reached.";
+                return;
+            }
+            scheduler.onSuccess();
+
+            if (ResponseCache::isCacheable(body))
+                cache.put(keys[i], functions[i], body);
+            parse(i, body);
+        };
+
+        auto admit = [&](size_t) { return scheduler.tryAcquire(priority); };
+
+        if (transport->isRateLimited())
+            transport->getMany(pending_urls, max_concurrent, on_complete,
+                               admit);
+        else
+            transport->getMany(pending_urls, max_concurrent, on_complete);
+        pending = throttled;
+    }
+
+    return results;
+}
+
+} // namespace avapi
@@ -0,0 +1,279 @@
+#include <algorithm>
+#include <iomanip>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include "TablePrinter.hpp"
+#include "avapi/Container/FixedTimeSeries.hpp"
+
+namespace avapi {
+
+/// @brief Powers of ten of the supported scales
+static const int64_t POW10[] = {1,         10,         100,       1000,
+                                10000,     100000,     1000000,   10000000,
+                                100000000, 1000000000, 10000000000};
+
+/// @brief Constructor
+/// @param decimals: Decimal places kept, ticks are 10^-decimals (default = 4)
+FixedTimeSeries::FixedTimeSeries(const unsigned &decimals)
+    : type(avapi::SeriesType::DAILY), market("USD"), m_decimals(decimals)
+{
+    if (decimals > 10) {
+        throw std::invalid_argument("avapi/FixedTimeSeries.cpp: "
+                                    "'FixedTimeSeries': at most 10 decimals.");
+    }
+    m_scale = POW10[decimals];
+}
+
+/// @brief Reserve storage for a known number of rows
+/// @param rows: The expected row count
+void FixedTimeSeries::reserve(const size_t &rows)
+{
+    m_timestamps.reserve(rows);
+    for (auto &col : m_columns)
+        col.reserve(rows);
+}
+
+/// @brief Append a row
+/// @param timestamp: The row's timestamp
+/// @param ticks: The row's values, in ticks. The first row sets the column
+/// count, later rows are padded with 0 or cut to it.
+void FixedTimeSeries::appendRow(const std::time_t &timestamp,
+                                const std::vector<int64_t> &ticks)
+{
+    if (m_timestamps.empty() && m_columns.empty())
+        m_columns.resize(ticks.size());
+
+    m_timestamps.push_back(timestamp);
+    for (size_t i = 0; i < m_columns.size(); ++i)
+        m_columns[i].push_back(i < ticks.size() ? ticks[i] : 0);
+}
+
+/// @brief Reverses the rows, as TimeSeries::reverseData()
+void FixedTimeSeries::reverseData()
+{
+    std::reverse(m_timestamps.begin(), m_timestamps.end());
+    for (auto &col : m_columns)
+        std::reverse(col.begin(), col.end());
+}
+
+/// @brief Get one value in ticks
+/// @param row: The row index
+/// @param col: The column's index among the values
+int64_t FixedTimeSeries::ticks(const size_t &row, const size_t &col)
+{
+    return m_columns[col][row];
+}
+
+/// @brief Get one value as a double, for code expecting TimeSeries values
+/// @param row: The row index
+/// @param col: The column's index among the values
+double FixedTimeSeries::value(const size_t &row, const size_t &col)
+{
+    return static_cast<double>(m_columns[col][row]) / m_scale;
+}
+
+/// @brief Get every value of one column, in ticks
+/// @param col: The column's index among the values
+const std::vector<int64_t> &FixedTimeSeries::column(const size_t &col)
+{
+    if (col >= m_columns.size()) {
+        throw std::out_of_range("avapi/FixedTimeSeries.cpp: 'FixedTimeSeries::"
+                                "column': column index out of range.");
+    }
+    return m_columns[col];
+}
+
+/// @brief Exact sum of a column, in ticks
+/// @param col: The column's index among the values
+int64_t FixedTimeSeries::sum(const size_t &col)
+{
+    const std::vector<int64_t> &values = column(col);
+    return std::accumulate(values.begin(), values.end(), int64_t(0));
+}
+
+/// @brief Smallest value of a column, in ticks (0 if empty)
+/// @param col: The column's index among the values
+int64_t FixedTimeSeries::min(const size_t &col)
+{
+    const std::vector<int64_t> &values = column(col);
+    if (values.empty())
+        return 0;
+    return *std::min_element(values.begin(), values.end());
+}
+
+/// @brief Largest value of a column, in ticks (0 if empty)
+/// @param col: The column's index among the values
+int64_t FixedTimeSeries::max(const size_t &col)
+{
+    const std::vector<int64_t> &values = column(col);
+    if (values.empty())
+        return 0;
+    return *std::max_element(values.begin(), values.end());
+}
+
+/// @brief Convert to a TimeSeries of doubles
+TimeSeries FixedTimeSeries::toTimeSeries()
+{
+    TimeSeries series;
+    series.symbol = symbol;
+    series.type = type;
+    series.market = market;
+    series.title = title;
+    series.headers = headers;
+    series.reserve(rowCount());
+
+    std::vector<double> values(m_columns.size());
+    for (size_t row = 0; row < rowCount(); ++row) {
+        for (size_t col = 0; col < m_columns.size(); ++col)
+            values[col] = value(row, col);
+        series.appendRow(m_timestamps[row], values);
+    }
+    return series;
+}
+
+/// @brief Format a value exactly, with all of its decimals
+/// @param ticks: The value in ticks
+std::string FixedTimeSeries::toString(const int64_t &ticks) const
+{
+    uint64_t magnitude = ticks < 0 ? 0 - static_cast<uint64_t>(ticks)
+                                   : static_cast<uint64_t>(ticks);
+    std::string text = std::to_string(magnitude / m_scale);
+    if (m_decimals > 0) {
+        std::string fraction = std::to_string(magnitude % m_scale);
+        text += "." + std::string(m_decimals - fraction.size(), '0') +
+                fraction;
+    }
+    return ticks < 0 ? "-" + text : text;
+}
+
+/// @brief Read a decimal cell as ticks with integer arithmetic only. Digits
+/// beyond the series' decimals are truncated.
+/// @param cell: The cell, e.g. "130.2400"
+/// @param decimals: Decimal places of a tick
+/// @throws std::invalid_argument if cell is not a decimal number, or its
+/// ticks do not fit in an int64_t (above about 9.2e10 at 8 decimals)
+int64_t FixedTimeSeries::toTicks(std::string_view cell,
+                                 const unsigned &decimals)
+{
+    if (decimals > 10) {
+        throw std::invalid_argument("avapi/FixedTimeSeries.cpp: "
+                                    "'FixedTimeSeries::toTicks': at most 10 "
+                                    "decimals.");
+    }
+
+    const char *p = cell.data();
+    const char *end = p + cell.size();
+    bool negative = p != end && *p == '-';
+    if (p != end && (*p == '-' || *p == '+'))
+        ++p;
+
+    // Checked before every multiply and add, signed overflow is undefined
+    const int64_t max = std::numeric_limits<int64_t>::max();
+    bool overflow = false;
+
+    int64_t whole = 0;
+    size_t digits = 0;
+    while (p != end && static_cast<unsigned>(*p - '0') < 10) {
+        int digit = *p++ - '0';
+        if (whole > (max - digit) / 10)
+            overflow = true;
+        else
+            whole = whole * 10 + digit;
+        ++digits;
+    }
+
+    int64_t fraction = 0;
+    unsigned places = 0;
+    if (p != end && *p == '.') {
+        ++p;
+        while (p != end && static_cast<unsigned>(*p - '0') < 10) {
+            if (places < decimals) {
+                fraction = fraction * 10 + (*p - '0');
+                ++places;
+            }
+            ++p;
+            ++digits;
+        }
+    }
+
+    if (p != end || digits == 0) {
+        throw std::invalid_argument(
+            "avapi/FixedTimeSeries.cpp: 'FixedTimeSeries::toTicks': \"" +
+            std::string(cell) + "\" is not a decimal number.");
+    }
+
+    // fraction * 10^(decimals - places) < 10^decimals, it cannot overflow
+    int64_t part = fraction * POW10[decimals - places];
+    if (overflow || whole > (max - part) / POW10[decimals]) {
+        throw std::invalid_argument(
+            "avapi/FixedTimeSeries.cpp: 'FixedTimeSeries::toTicks': \"" +
+            std::string(cell) + "\" does not fit in 64 bit ticks of " +
+            std::to_string(decimals) + " decimals.");
+    }
+
+    int64_t ticks = whole * POW10[decimals] + part;
+    return negative ? -ticks : ticks;
+}
+
+/// @brief Print formatted FixedTimeSeries' data
+/// @param count: The # of rows to print (default = 0 or all)
+void FixedTimeSeries::printData(const size_t &count)
+{
+    using namespace dmf::tableprinter;
+
+    TablePrinter printer(this->title, this->headers);
+
+    for (size_t i = 0; i < printer.columns.size(); ++i) {
+        printer.columns[i].setWidth(14);
+        if (i != 0) {
+            printer.columns[i].data_fmt.alignment = Align::RIGHT;
+            printer.columns[i].data_fmt.additional =
+                "." + std::to_string(m_decimals) + "f";
+        }
+    }
+    printer.formatHeading();
+    printer.printHeading();
+
+    size_t n = count;
+    size_t n_rows = rowCount();
+
+    if (count > n_rows || count == 0)
+        n = n_rows;
+
+    // Print Data
+    for (size_t i = 0; i < n; ++i) {
+        std::vector<double> data_row = {(double)m_timestamps[i]};
+        for (size_t col = 0; col < m_columns.size(); ++col)
+            data_row.push_back(value(i, col));
+        printer.printDataRow(data_row);
+    }
+}
+
+/// @brief Push formatted FixedTimeSeries' data to ostream, values exact
+std::ostream &operator<<(std::ostream &os, const FixedTimeSeries &series)
+{
+    size_t width = 14 + series.m_decimals;
+    size_t sep_count = (series.headers.size() * width) + 10;
+    std::string separator(sep_count, '-');
+
+    os << separator << '\n';
+
+    for (auto &heading : series.headers) {
+        os << std::setw(width) << heading;
+    }
+
+    os << '\n' << separator << '\n';
+
+    for (size_t row = 0; row < series.m_timestamps.size(); ++row) {
+        os << std::setw(width) << std::right << series.m_timestamps[row];
+        for (auto &col : series.m_columns) {
+            os << std::setw(width) << std::right
+               << series.toString(col[row]);
+        }
+        os << '\n';
+    }
+    return os;
+}
+
+} // namespace avapi
@@ -0,0 +1,129 @@
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+#include "avapi/ResponseStatus.hpp"
+#include "avapi/Container/LazyTimeSeries.hpp"
+
+namespace avapi {
+
+/// @brief LazyTimeSeries constructor
+/// @param data: The csv response, kept as is
+LazyTimeSeries::LazyTimeSeries(std::string data)
+    : m_body(std::make_shared<const std::string>(std::move(data)))
+{
+    indexLines();
+}
+
+/// @brief LazyTimeSeries constructor
+/// @param data: The csv response, kept as is
+/// @param projection: The columns to keep
+/// @param zone: The time zone of the timestamps (default = US_EASTERN)
+LazyTimeSeries::LazyTimeSeries(std::string data,
+                               const CsvProjection &projection,
+                               const TimeZone &zone)
+    : m_body(std::make_shared<const std::string>(std::move(data))),
+      m_tokenizer(projection, zone)
+{
+    indexLines();
+}
+
+/// @brief Parse the header and record where every data line is. Nothing
+/// else of the body is read.
+void LazyTimeSeries::indexLines()
+{
+    ResponseStatus status = classifyResponse(*m_body);
+    if (status.json) {
+        throw ResponseError(status, "'avapi::LazyTimeSeries': Json Response:" +
+                                        *m_body);
+    }
+
+    std::string_view data = *m_body;
+    TimeSeries header;
+    size_t begin = 0;
+    while (begin < data.size()) {
+        const char *found = static_cast<const char *>(
+            std::memchr(data.data() + begin, '\n', data.size() - begin));
+        size_t end = found ? found - data.data() : data.size();
+
+        std::string_view line = data.substr(begin, end - begin);
+        begin = end + 1;
+        if (!m_tokenizer.headerDone())
+            m_tokenizer.parseHeader(line, header);
+        else if (!line.empty() && line != "\r")
+            m_lines.push_back(line);
+    }
+    headers = std::move(header.headers);
+
+    // Empty rows, their data vectors do not allocate until parsed
+    m_rows.assign(m_lines.size(), TimePair(0, std::vector<double>()));
+    m_parsed.assign(m_lines.size(), false);
+}
+
+/// @brief Get a row, parsing it on first access
+/// @param i: The row index
+const TimePair &LazyTimeSeries::operator[](size_t i)
+{
+    if (i >= m_lines.size()) {
+        throw std::out_of_range("avapi/LazyTimeSeries.cpp: 'LazyTimeSeries::"
+                                "operator[]': row index out of range.");
+    }
+    if (!m_parsed[i]) {
+        m_tokenizer.parseRow(m_lines[i], m_rows[i]);
+        m_parsed[i] = true;
+    }
+    return m_rows[i];
+}
+
+/// @brief Get every row's value of one column, parsing only that column's
+/// cells on first access
+/// @param index: The column's index within TimePair::data
+const std::vector<double> &LazyTimeSeries::column(const size_t &index)
+{
+    auto found = m_columns.find(index);
+    if (found != m_columns.end())
+        return found->second;
+
+    std::vector<double> values;
+    values.reserve(m_lines.size());
+    for (size_t i = 0; i < m_lines.size(); ++i) {
+        if (m_parsed[i] && index < m_rows[i].data.size())
+            values.push_back(m_rows[i].data[index]);
+        else
+            values.push_back(m_tokenizer.parseValue(m_lines[i], index));
+    }
+    return m_columns.emplace(index, std::move(values)).first->second;
+}
+
+/// @brief Get every row's timestamp, parsing only the first cell of each
+/// row on first access
+const std::vector<std::time_t> &LazyTimeSeries::timestamps()
+{
+    if (m_timestamps.size() == m_lines.size())
+        return m_timestamps;
+
+    // Kept only once every row parsed, a bad cell leaves no partial column
+    std::vector<std::time_t> timestamps;
+    timestamps.reserve(m_lines.size());
+    for (size_t i = 0; i < m_lines.size(); ++i) {
+        if (m_parsed[i])
+            timestamps.push_back(m_rows[i].timestamp);
+        else
+            timestamps.push_back(m_tokenizer.parseTimestamp(m_lines[i]));
+    }
+    m_timestamps.swap(timestamps);
+    return m_timestamps;
+}
+
+/// @brief Parse every row not yet parsed into an eager TimeSeries
+/// @returns The TimeSeries (without symbol, type or title set)
+TimeSeries LazyTimeSeries::materialize()
+{
+    TimeSeries series;
+    series.headers = headers;
+    series.reserve(m_lines.size());
+    for (size_t i = 0; i < m_lines.size(); ++i)
+        series.pushBack((*this)[i]);
+    return series;
+}
+
+} // namespace avapi
@@ -1,11 +1,15 @@
+#include <algorithm>
 #include <iostream>
 #include <iomanip>
+#include <limits>
+#include <stdexcept>
 #include <nlohmann/json.hpp>
 #include <fmt/core.h>
 #include <fmt/ranges.h>
 #include "rapidcsv.h"
 #include "TablePrinter.hpp"
 #include "avapi/misc.hpp"
+#include "avapi/CsvProjection.hpp"
 #include "avapi/Container/TimePair.hpp"
 #include "avapi/Container/TimeSeries.hpp"
 
@@ -17,32 +21,232 @@ TimeSeries::TimeSeries()
 {
 }
 
+/// @brief Constructor
+/// @param resource: The memory resource the columns are drawn from, e.g. a
+/// std::pmr::monotonic_buffer_resource shared by a whole universe of series.
+/// It must outlive the TimeSeries.
+TimeSeries::TimeSeries(std::pmr::memory_resource *resource)
+    : type(avapi::SeriesType::DAILY), is_adjusted(false), market("USD"),
+      m_timestamps(resource), m_columns(resource)
+{
+}
+
 /// @brief Constructor
 /// @param data: A vector of avapi::TimePair data
 TimeSeries::TimeSeries(const std::vector<avapi::TimePair> &data)
-    : type(avapi::SeriesType::DAILY), is_adjusted(false), market("USD"),
-      data_series(data)
+    : type(avapi::SeriesType::DAILY), is_adjusted(false), market("USD")
 {
+    reserve(data.size());
+    for (auto &pair : data)
+        pushBack(pair);
 }
 
-/// @brief Copy constructor
+/// @brief Copy constructor, the copy's columns are on the default heap
 TimeSeries::TimeSeries(const TimeSeries &series)
     : symbol(series.symbol), type(series.type), is_adjusted(series.is_adjusted),
-      market(series.market), title(series.title), headers(series.headers),
-      data_series(series.data_series)
+      market(series.market), interval(series.interval), title(series.title),
+      headers(series.headers),
+      m_timestamps(series.m_timestamps), m_columns(series.m_columns)
+{
+}
+
+/// @brief Copy constructor
+/// @param series: The TimeSeries to copy
+/// @param resource: The memory resource the copy's columns are drawn from
+TimeSeries::TimeSeries(const TimeSeries &series,
+                       std::pmr::memory_resource *resource)
+    : symbol(series.symbol), type(series.type), is_adjusted(series.is_adjusted),
+      market(series.market), interval(series.interval), title(series.title),
+      headers(series.headers),
+      m_timestamps(series.m_timestamps, resource),
+      m_columns(series.m_columns, resource)
 {
 }
 
+/// @brief Move constructor, the columns are handed over without copying
+TimeSeries::TimeSeries(TimeSeries &&series) noexcept = default;
+
+/// @brief Copy assignment
+TimeSeries &TimeSeries::operator=(const TimeSeries &series) = default;
+
+/// @brief Move assignment. The columns are handed over without copying
+/// when both series share a memory resource, otherwise they are copied into
+/// this series' resource.
+TimeSeries &TimeSeries::operator=(TimeSeries &&series) = default;
+
+/// @brief Get the memory resource the columns are drawn from
+std::pmr::memory_resource *TimeSeries::resource() const
+{
+    return m_timestamps.get_allocator().resource();
+}
+
 /// @brief Push TimePair data into the TimeSeries
 /// @param pair: A TimePair to be pushed back
-void TimeSeries::pushBack(const TimePair &pair) { data_series.push_back(pair); }
+void TimeSeries::pushBack(const TimePair &pair)
+{
+    appendRow(pair.timestamp, pair.data.data(), pair.data.size());
+}
+
+/// @brief Push TimePair data into the TimeSeries. Values are stored by
+/// column, so the pair's vector is read, not kept.
+/// @param pair: A TimePair to be pushed back
+void TimeSeries::pushBack(TimePair &&pair)
+{
+    appendRow(pair.timestamp, pair.data.data(), pair.data.size());
+}
+
+/// @brief Append a row. The first row of an empty TimeSeries sets the
+/// column count, later rows are cut to it or padded with NaN.
+/// @param timestamp: The row's timestamp
+/// @param data: The row's values
+void TimeSeries::appendRow(const std::time_t &timestamp,
+                           const std::vector<double> &data)
+{
+    appendRow(timestamp, data.data(), data.size());
+}
+
+/// @brief Append a row without any allocation once reserve() was called
+/// @param timestamp: The row's timestamp
+/// @param data: The row's values
+/// @param count: The # of values
+void TimeSeries::appendRow(const std::time_t &timestamp, const double *data,
+                           const size_t &count)
+{
+    // Columns created after reserve() get the reserved capacity too
+    if (m_timestamps.empty() && m_columns.empty()) {
+        m_columns.resize(count);
+        for (auto &column : m_columns)
+            column.reserve(m_timestamps.capacity());
+    }
+
+    m_timestamps.push_back(timestamp);
+    for (size_t i = 0; i < m_columns.size(); ++i) {
+        m_columns[i].push_back(i < count
+                                   ? data[i]
+                                   : std::numeric_limits<double>::quiet_NaN());
+    }
+}
+
+/// @brief Append every row of another TimeSeries, column by column. An
+/// empty TimeSeries takes its columns and headers.
+/// @param rows: The rows to append
+void TimeSeries::append(const TimeSeries &rows)
+{
+    if (m_timestamps.empty() && m_columns.empty()) {
+        m_columns.resize(rows.m_columns.size());
+        headers = rows.headers;
+        reserve(rows.m_timestamps.size());
+    }
+    copyRows(rows, 0, rows.m_timestamps.size(), false);
+}
+
+/// @brief Append the rows [first, last) of from, in reverse order if
+/// reversed. Columns from lacks are padded with NaN.
+void TimeSeries::copyRows(const TimeSeries &from, const size_t &first,
+                          const size_t &last, const bool &reversed)
+{
+    auto copy = [&](auto &to, const auto &values) {
+        if (reversed) {
+            size_t size = values.size();
+            to.insert(to.end(), values.rbegin() + (size - last),
+                      values.rbegin() + (size - first));
+        }
+        else {
+            to.insert(to.end(), values.begin() + first, values.begin() + last);
+        }
+    };
+
+    copy(m_timestamps, from.m_timestamps);
+    for (size_t i = 0; i < m_columns.size(); ++i) {
+        if (i < from.m_columns.size()) {
+            copy(m_columns[i], from.m_columns[i]);
+        }
+        else {
+            m_columns[i].insert(m_columns[i].end(), last - first,
+                                std::numeric_limits<double>::quiet_NaN());
+        }
+    }
+}
+
+/// @brief Reserve storage for a known number of rows
+/// @param rows: The expected row count
+void TimeSeries::reserve(const size_t &rows)
+{
+    m_timestamps.reserve(rows);
+    for (auto &column : m_columns)
+        column.reserve(rows);
+}
 
 /// @brief Reverses the TimeSeries' data, useful for when the data is
 /// desired to be plotted
 void TimeSeries::reverseData()
 {
     // Data coming from Alpha Vantage is reversed (Dates are reversed)
-    std::reverse(data_series.begin(), data_series.end());
+    std::reverse(m_timestamps.begin(), m_timestamps.end());
+    for (auto &column : m_columns)
+        std::reverse(column.begin(), column.end());
+}
+
+/// @brief Merge a newer download of the same series into this one. Every row
+/// at or after the update's oldest timestamp is replaced by the update, which
+/// picks up new bars as well as revised ones (e.g. a still forming weekly bar
+/// whose timestamp moved). The row order of this TimeSeries is kept.
+/// @param update: A TimeSeries overlapping the newest row of this one, with
+/// the same columns
+/// @returns false, leaving this TimeSeries unchanged, if the update starts
+/// after this series' newest row and rows could be missing in between
+/// @throws std::invalid_argument if the update's columns differ from this
+/// series' columns, e.g. it was parsed with another CsvProjection
+bool TimeSeries::merge(const TimeSeries &update)
+{
+    const std::pmr::vector<std::time_t> &rows = update.m_timestamps;
+    if (rows.empty())
+        return true;
+
+    if (!m_timestamps.empty() &&
+        (update.m_columns.size() != m_columns.size() ||
+         (!headers.empty() && !update.headers.empty() &&
+          update.headers != headers))) {
+        throw std::invalid_argument(
+            "avapi/TimeSeries.cpp: 'TimeSeries::merge': The update's columns "
+            "differ from the series' columns.");
+    }
+
+    bool update_descending = rows.front() >= rows.back();
+    std::time_t update_oldest =
+        update_descending ? rows.back() : rows.front();
+
+    if (m_timestamps.empty()) {
+        m_timestamps = update.m_timestamps;
+        m_columns = update.m_columns;
+        headers = update.headers;
+        return true;
+    }
+
+    // Alpha Vantage sends the newest rows first, unless reverseData() was used
+    bool descending = m_timestamps.front() >= m_timestamps.back();
+    std::time_t newest =
+        descending ? m_timestamps.front() : m_timestamps.back();
+    if (update_oldest > newest)
+        return false;
+
+    bool reversed = update_descending != descending;
+
+    TimeSeries merged(resource());
+    merged.m_columns.resize(m_columns.size());
+    merged.reserve(m_timestamps.size() + rows.size());
+    if (descending)
+        merged.copyRows(update, 0, rows.size(), reversed);
+    for (size_t i = 0; i < m_timestamps.size(); ++i) {
+        if (m_timestamps[i] < update_oldest)
+            merged.copyRows(*this, i, i + 1, false);
+    }
+    if (!descending)
+        merged.copyRows(update, 0, rows.size(), reversed);
+
+    m_timestamps.swap(merged.m_timestamps);
+    m_columns.swap(merged.m_columns);
+    return true;
 }
 
 /// @brief Print formatted TimeSeries' data
@@ -71,9 +275,9 @@ void TimeSeries::printData(const size_t &count)
 
     // Print Data
     for (size_t i = 0; i < n; ++i) {
-        std::vector<double> data_row = {(double)data_series[i].timestamp};
-        data_row.insert(data_row.end(), data_series[i].data.begin(),
-                        data_series[i].data.end());
+        std::vector<double> data_row = {(double)m_timestamps[i]};
+        for (auto &column : m_columns)
+            data_row.push_back(column[i]);
         printer.printDataRow(data_row);
     }
 }
@@ -121,10 +325,134 @@ void TimeSeries::printData(const size_t &count)
 //}
 
 /// @brief Get the TimeSeries' row count
-size_t TimeSeries::rowCount() { return data_series.size(); }
+size_t TimeSeries::rowCount() { return m_timestamps.size(); }
 
 /// @brief Get the TimeSeries' column count
-size_t TimeSeries::colCount() { return data_series[0].data.size() + 1; }
+size_t TimeSeries::colCount() { return m_columns.size() + 1; }
+
+/// @brief Get the # of rows that fit before the columns grow
+size_t TimeSeries::capacity() { return m_timestamps.capacity(); }
+
+/// @brief Get every row's timestamp
+Span<std::time_t> TimeSeries::timestamps()
+{
+    return Span<std::time_t>(m_timestamps.data(), m_timestamps.size());
+}
+
+/// @brief Get every row's value of one column
+/// @param index: The column's index within a row's data
+Span<double> TimeSeries::column(const size_t &index)
+{
+    if (index >= m_columns.size()) {
+        throw std::out_of_range("avapi/TimeSeries.cpp: 'TimeSeries::column': "
+                                "column index out of range.");
+    }
+    return Span<double>(m_columns[index].data(), m_columns[index].size());
+}
+
+/// @brief Get every row's value of the column with the given header. Names
+/// match as in avapi::CsvProjection, e.g. "close" matches "close (USD)".
+/// @param name: The column's header
+Span<double> TimeSeries::column(const std::string &name)
+{
+    std::vector<std::string_view> names(headers.begin(), headers.end());
+    std::vector<bool> keep = CsvProjection({name}).select(names);
+
+    // keep[0] is the timestamp column
+    for (size_t i = 1; i < keep.size() && i <= m_columns.size(); ++i) {
+        if (keep[i])
+            return column(i - 1);
+    }
+    throw std::out_of_range("avapi/TimeSeries.cpp: 'TimeSeries::column': no "
+                            "\"" + name + "\" column.");
+}
+
+/// @brief Test if the rows are newest first, as Alpha Vantage sends them
+bool TimeSeries::isDescending()
+{
+    return !m_timestamps.empty() && m_timestamps.front() > m_timestamps.back();
+}
+
+/// @brief Binary search for the oldest row at or after a time, in either
+/// row order
+/// @param time: The UNIX timestamp
+/// @returns The row index, rowCount() if every row is older
+size_t TimeSeries::lowerBound(const std::time_t &time)
+{
+    if (isDescending()) {
+        // Rows at or after time are the leading ones
+        auto end = std::partition_point(
+            m_timestamps.begin(), m_timestamps.end(),
+            [&](const std::time_t &stamp) { return stamp >= time; });
+        size_t count = end - m_timestamps.begin();
+        return count == 0 ? rowCount() : count - 1;
+    }
+    return std::lower_bound(m_timestamps.begin(), m_timestamps.end(), time) -
+           m_timestamps.begin();
+}
+
+/// @brief View the rows from one time to another, both included, found by
+/// binary search in either row order
+/// @param from: The oldest UNIX timestamp
+/// @param to: The newest UNIX timestamp
+TimeSeries::View TimeSeries::slice(const std::time_t &from,
+                                   const std::time_t &to)
+{
+    auto begin = m_timestamps.begin();
+    auto end = m_timestamps.end();
+    if (to < from)
+        return View(*this, 0, 0);
+
+    if (isDescending()) {
+        auto newer = [&](const std::time_t &t) { return t > to; };
+        auto inside = [&](const std::time_t &t) { return t >= from; };
+        auto first = std::partition_point(begin, end, newer);
+        auto last = std::partition_point(first, end, inside);
+        return View(*this, first - begin, last - begin);
+    }
+    auto first = std::lower_bound(begin, end, from);
+    auto last = std::upper_bound(first, end, to);
+    return View(*this, first - begin, last - begin);
+}
+
+/// @brief View the newest rows, in either row order
+/// @param count: The # of rows
+TimeSeries::View TimeSeries::last(const size_t &count)
+{
+    size_t n = std::min(count, rowCount());
+    if (isDescending())
+        return View(*this, 0, n);
+    return View(*this, rowCount() - n, rowCount());
+}
+
+/// @brief View the rows [first, last) by position
+/// @param first: Index of the first row
+/// @param last: One past the index of the last row
+TimeSeries::View TimeSeries::rows(const size_t &first, const size_t &last)
+{
+    if (first > last || last > rowCount()) {
+        throw std::out_of_range("avapi/TimeSeries.cpp: 'TimeSeries::rows': "
+                                "row range out of range.");
+    }
+    return View(*this, first, last);
+}
+
+/// @brief Copy the viewed rows into a TimeSeries of their own
+TimeSeries TimeSeries::View::toTimeSeries() const
+{
+    TimeSeries series(m_series->resource());
+    series.symbol = m_series->symbol;
+    series.type = m_series->type;
+    series.is_adjusted = m_series->is_adjusted;
+    series.market = m_series->market;
+    series.interval = m_series->interval;
+    series.title = m_series->title;
+    series.headers = m_series->headers;
+    series.m_columns.resize(m_series->m_columns.size());
+    series.reserve(m_count);
+    series.copyRows(*m_series, m_first, m_first + m_count, false);
+    return series;
+}
 
 /// @brief Push formatted TimeSeries' data to ostream
 std::ostream &operator<<(std::ostream &os, const TimeSeries &series)
@@ -141,11 +469,11 @@ std::ostream &operator<<(std::ostream &os, const TimeSeries &series)
 
     os << '\n' << separator << '\n';
 
-    for (auto &pair : series.data_series) {
-        os << std::setw(width) << std::right << pair.timestamp;
-        for (auto &value : pair.data) {
+    for (size_t row = 0; row < series.m_timestamps.size(); ++row) {
+        os << std::setw(width) << std::right << series.m_timestamps[row];
+        for (auto &column : series.m_columns) {
             os << std::setw(width) << std::right << std::fixed
-               << std::setprecision(2) << value;
+               << std::setprecision(2) << column[row];
         }
         os << '\n';
     }
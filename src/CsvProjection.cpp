@@ -0,0 +1,101 @@
+#include "avapi/misc.hpp"
+#include "avapi/CsvProjection.hpp"
+
+namespace avapi {
+
+/// @brief Keep the named columns
+/// @param names: Header names, e.g. {"close", "volume"}
+CsvProjection::CsvProjection(std::initializer_list<std::string> names)
+    : m_names(names)
+{
+}
+
+/// @brief Keep the named columns
+/// @param names: Header names, e.g. {"close", "volume"}
+CsvProjection::CsvProjection(const std::vector<std::string> &names)
+    : m_names(names)
+{
+}
+
+/// @brief Keep the columns at the given indices
+/// @param indices: Column indices, the timestamp column being 0
+CsvProjection::CsvProjection(std::initializer_list<size_t> indices)
+    : m_indices(indices)
+{
+}
+
+/// @brief The columns avapi keeps for cryptocurrency series. Alpha Vantage
+/// repeats open, high, low and close in USD and adds a market cap equal to
+/// the volume, those columns are dropped.
+CsvProjection CsvProjection::crypto()
+{
+    return CsvProjection({"open", "high", "low", "close", "volume"});
+}
+
+/// @brief The projection keeping the columns named in headers, so that a
+/// later download of the same series is parsed into the same columns
+/// @param headers: The headers of a parsed TimeSeries, timestamp first
+CsvProjection CsvProjection::matching(const std::vector<std::string> &headers)
+{
+    if (headers.size() <= 1)
+        return CsvProjection();
+    return CsvProjection(
+        std::vector<std::string>(headers.begin() + 1, headers.end()));
+}
+
+/// @brief Decide which columns of a header line are kept
+/// @param headers: The header line's cells
+/// @returns One flag per column, true when it is kept
+std::vector<bool>
+CsvProjection::select(const std::vector<std::string_view> &headers) const
+{
+    if (keepsAll())
+        return std::vector<bool>(headers.size(), true);
+
+    std::vector<bool> keep(headers.size(), false);
+    if (!keep.empty())
+        keep[0] = true;
+
+    for (size_t index : m_indices) {
+        if (index < keep.size())
+            keep[index] = true;
+    }
+    for (const auto &name : m_names) {
+        for (size_t i = 1; i < headers.size(); ++i) {
+            if (matches(name, headers[i])) {
+                keep[i] = true;
+                break;
+            }
+        }
+    }
+    return keep;
+}
+
+/// @brief A string identifying the projection, used to tell apart requests
+/// that only differ in their projection. Names and indices are prefixed with
+/// their kind, so {"1"} and {1} get different keys.
+std::string CsvProjection::key() const
+{
+    std::string key;
+    for (const auto &name : m_names)
+        key += "n" + std::to_string(name.size()) + ":" + name + ",";
+    for (size_t index : m_indices)
+        key += "i" + std::to_string(index) + ",";
+    return key;
+}
+
+/// @brief Test if a projected name selects a header
+/// @param name: The projected name
+/// @param header: The header cell
+bool CsvProjection::matches(std::string_view name, std::string_view header)
+{
+    if (header == name || normalizeHeader(std::string(header)) == name)
+        return true;
+
+    // "close (CNY)"
+    return header.size() > name.size() + 1 &&
+           header.substr(0, name.size()) == name &&
+           header.substr(name.size(), 2) == " (";
+}
+
+} // namespace avapi
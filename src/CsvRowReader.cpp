@@ -0,0 +1,132 @@
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+#include "avapi/CsvRowReader.hpp"
+#include "avapi/ResponseStatus.hpp"
+
+namespace avapi {
+
+/// @brief CsvRowReader constructor, the header is read right away
+/// @param file_path: The csv file's path
+CsvRowReader::CsvRowReader(const std::string &file_path)
+{
+    open(file_path);
+}
+
+/// @brief CsvRowReader constructor, the header is read right away
+/// @param file_path: The csv file's path
+/// @param projection: The columns to keep
+/// @param zone: The time zone of the timestamps (default = US_EASTERN)
+CsvRowReader::CsvRowReader(const std::string &file_path,
+                           const CsvProjection &projection,
+                           const TimeZone &zone)
+    : m_tokenizer(projection, zone)
+{
+    open(file_path);
+}
+
+/// @brief Open the file and parse its header. A JSON body (an Alpha
+/// Vantage error or notice saved to disk) throws an avapi::ResponseError.
+/// @param file_path: The csv file's path
+void CsvRowReader::open(const std::string &file_path)
+{
+    m_file.open(file_path, std::ios::binary);
+    if (!m_file) {
+        throw std::runtime_error("avapi/CsvRowReader.cpp: 'CsvRowReader': \"" +
+                                 file_path + "\" cannot be opened");
+    }
+    m_buffer.resize(64 * 1024);
+    fill();
+
+    std::string_view start(m_buffer.data(), m_end);
+    size_t first = start.find_first_not_of(" \t\r\n");
+    if (first != std::string_view::npos && start[first] == '{') {
+        std::string body(start);
+        body.append(std::istreambuf_iterator<char>(m_file),
+                    std::istreambuf_iterator<char>());
+        throw ResponseError(classifyResponse(body),
+                            "'avapi::CsvRowReader': Json Response:" + body);
+    }
+
+    TimeSeries header;
+    std::string_view line;
+    while (!m_tokenizer.headerDone() && nextLine(line))
+        m_tokenizer.parseHeader(line, header);
+    m_headers = std::move(header.headers);
+}
+
+/// @brief Read the next data row
+/// @param row: Receives the row, its data vector is reused
+/// @returns false once the file is exhausted
+bool CsvRowReader::next(TimePair &row)
+{
+    std::string_view line;
+    while (nextLine(line)) {
+        if (line.empty() || line == "\r")
+            continue;
+        m_tokenizer.parseRow(line, row);
+        ++m_rows;
+        return true;
+    }
+    return false;
+}
+
+/// @brief Call back with every remaining row
+/// @param callback: Called with each row, valid for the call only
+/// @returns The number of rows read
+size_t CsvRowReader::forEach(const RowCallback &callback)
+{
+    size_t count = 0;
+    while (next(m_row)) {
+        callback(m_row);
+        ++count;
+    }
+    return count;
+}
+
+/// @brief View the next line of the buffer, refilling it as needed
+/// @param line: Receives the line, without its '\n', valid until the next
+/// call
+/// @returns false once the file is exhausted
+bool CsvRowReader::nextLine(std::string_view &line)
+{
+    while (true) {
+        const char *begin = m_buffer.data() + m_begin;
+        const char *newline = static_cast<const char *>(
+            std::memchr(begin, '\n', m_end - m_begin));
+        if (newline != nullptr) {
+            line = std::string_view(begin, newline - begin);
+            m_begin += line.size() + 1;
+            return true;
+        }
+        if (!fill()) {
+            line = std::string_view(m_buffer.data() + m_begin, m_end - m_begin);
+            m_begin = m_end;
+            return !line.empty();
+        }
+    }
+}
+
+/// @brief Move the unfinished line to the front of the buffer and read
+/// after it. The buffer only grows for a line longer than itself.
+/// @returns false if nothing more could be read
+bool CsvRowReader::fill()
+{
+    if (m_eof)
+        return false;
+
+    std::memmove(m_buffer.data(), m_buffer.data() + m_begin, m_end - m_begin);
+    m_end -= m_begin;
+    m_begin = 0;
+    if (m_end == m_buffer.size())
+        m_buffer.resize(m_buffer.size() * 2);
+
+    m_file.read(m_buffer.data() + m_end, m_buffer.size() - m_end);
+    size_t count = static_cast<size_t>(m_file.gcount());
+    m_end += count;
+    if (count == 0)
+        m_eof = true;
+    return count > 0;
+}
+
+} // namespace avapi
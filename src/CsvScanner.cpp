@@ -0,0 +1,184 @@
+#include "avapi/CsvScanner.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define AVAPI_X86_SIMD
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define AVAPI_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define AVAPI_TARGET_AVX2
+#endif
+
+namespace avapi {
+
+/// @brief Scalar scan, also used for the tail of the SIMD scans
+/// @param data: The block
+/// @param begin: Offset to start at
+/// @param size: Size of the block
+/// @param out: Receives the offsets
+/// @returns Pointer past the last written offset
+static uint32_t *scanScalar(const char *data, size_t begin, size_t size,
+                            uint32_t *out)
+{
+    for (size_t i = begin; i < size; ++i) {
+        if (data[i] == ',' || data[i] == '\n')
+            *out++ = static_cast<uint32_t>(i);
+    }
+    return out;
+}
+
+#ifdef AVAPI_X86_SIMD
+
+/// @brief Count the trailing zero bits of a non zero mask
+static inline unsigned trailingZeros(uint32_t mask)
+{
+#ifdef _MSC_VER
+    unsigned long bit;
+    _BitScanForward(&bit, mask);
+    return bit;
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+/// @brief Write the offset of every set bit of mask
+static inline uint32_t *extract(uint32_t mask, uint32_t base, uint32_t *out)
+{
+    while (mask != 0) {
+        *out++ = base + trailingZeros(mask);
+        mask &= mask - 1;
+    }
+    return out;
+}
+
+/// @brief SSE2 scan, 16 bytes per step
+static uint32_t *scanSse2(const char *data, size_t size, uint32_t *out)
+{
+    const __m128i comma = _mm_set1_epi8(',');
+    const __m128i newline = _mm_set1_epi8('\n');
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        __m128i bytes =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+        __m128i hits = _mm_or_si128(_mm_cmpeq_epi8(bytes, comma),
+                                    _mm_cmpeq_epi8(bytes, newline));
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(hits));
+        out = extract(mask, static_cast<uint32_t>(i), out);
+    }
+    return scanScalar(data, i, size, out);
+}
+
+/// @brief AVX2 scan, 32 bytes per step
+AVAPI_TARGET_AVX2
+static uint32_t *scanAvx2(const char *data, size_t size, uint32_t *out)
+{
+    const __m256i comma = _mm256_set1_epi8(',');
+    const __m256i newline = _mm256_set1_epi8('\n');
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        __m256i bytes =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+        __m256i hits = _mm256_or_si256(_mm256_cmpeq_epi8(bytes, comma),
+                                       _mm256_cmpeq_epi8(bytes, newline));
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(hits));
+        out = extract(mask, static_cast<uint32_t>(i), out);
+    }
+    return scanScalar(data, i, size, out);
+}
+
+#endif
+
+/// @brief CsvScanner constructor
+/// @param level: Instruction set to use, lowered to what the CPU supports
+CsvScanner::CsvScanner(const SimdLevel &level) : m_level(SimdLevel::SCALAR)
+{
+    setLevel(level);
+}
+
+/// @brief Select the instruction set, lowered to what the CPU supports
+/// @param level: The requested instruction set
+void CsvScanner::setLevel(const SimdLevel &level)
+{
+    m_level = level;
+    while (!supported(m_level))
+        m_level = static_cast<SimdLevel>(static_cast<int>(m_level) - 1);
+}
+
+/// @brief Index every ',' and '\n' of block, see index()
+/// @param block: The csv block
+/// @returns The number of offsets found
+size_t CsvScanner::scan(std::string_view block)
+{
+    // Every byte may be a separator, the buffer only ever grows
+    if (m_index.size() < block.size())
+        m_index.resize(block.size());
+
+    const char *data = block.data();
+    uint32_t *out = m_index.data();
+    uint32_t *end;
+    switch (m_level) {
+#ifdef AVAPI_X86_SIMD
+    case SimdLevel::AVX2:
+        end = scanAvx2(data, block.size(), out);
+        break;
+    case SimdLevel::SSE2:
+        end = scanSse2(data, block.size(), out);
+        break;
+#endif
+    default:
+        end = scanScalar(data, 0, block.size(), out);
+        break;
+    }
+    return static_cast<size_t>(end - out);
+}
+
+/// @brief Test if the CPU running this supports an instruction set
+/// @param level: The instruction set
+bool CsvScanner::supported(const SimdLevel &level)
+{
+    switch (level) {
+    case SimdLevel::SCALAR:
+        return true;
+#ifdef AVAPI_X86_SIMD
+    case SimdLevel::SSE2:
+        // Part of x86-64 itself
+        return true;
+    case SimdLevel::AVX2:
+#ifdef _MSC_VER
+    {
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7)
+            return false;
+        __cpuid(info, 1);
+        // OSXSAVE and the OS saving the ymm registers
+        if ((info[2] & (1 << 27)) == 0 || (_xgetbv(0) & 6) != 6)
+            return false;
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+    }
+#else
+        return __builtin_cpu_supports("avx2");
+#endif
+#endif
+    default:
+        return false;
+    }
+}
+
+/// @brief The fastest instruction set supported by the CPU running this
+SimdLevel CsvScanner::bestLevel()
+{
+    static const SimdLevel best = supported(SimdLevel::AVX2) ? SimdLevel::AVX2
+                                  : supported(SimdLevel::SSE2)
+                                      ? SimdLevel::SSE2
+                                      : SimdLevel::SCALAR;
+    return best;
+}
+
+} // namespace avapi
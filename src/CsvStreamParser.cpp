@@ -0,0 +1,94 @@
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+#include "avapi/CsvStreamParser.hpp"
+#include "avapi/ResponseStatus.hpp"
+
+namespace avapi {
+
+/// @brief CsvStreamParser constructor, keeping every column
+CsvStreamParser::CsvStreamParser() {}
+
+/// @brief CsvStreamParser constructor
+/// @param projection: The columns to keep
+/// @param zone: The time zone of the timestamps (default = US_EASTERN)
+CsvStreamParser::CsvStreamParser(const CsvProjection &projection,
+                                 const TimeZone &zone)
+    : m_tokenizer(projection, zone)
+{
+}
+
+/// @brief Parse every complete line of a chunk, carrying the rest over
+/// @param data: The chunk
+/// @param size: The chunk's size in bytes
+void CsvStreamParser::feed(const char *data, const size_t &size)
+{
+    const char *begin = data;
+    const char *end = data + size;
+
+    // Decide between csv and a JSON error body on the first visible byte
+    if (!m_started) {
+        while (begin != end && std::strchr(" \t\r\n", *begin) != nullptr)
+            ++begin;
+        if (begin == end)
+            return;
+        m_started = true;
+        m_json = *begin == '{';
+    }
+
+    if (m_json) {
+        m_body.append(begin, end);
+        return;
+    }
+
+    while (begin != end) {
+        const char *newline =
+            static_cast<const char *>(std::memchr(begin, '\n', end - begin));
+        if (newline == nullptr) {
+            m_partial.append(begin, end);
+            return;
+        }
+
+        if (m_partial.empty()) {
+            parseLine(begin, newline);
+        }
+        else {
+            m_partial.append(begin, newline);
+            parseLine(m_partial.data(), m_partial.data() + m_partial.size());
+            m_partial.clear();
+        }
+        begin = newline + 1;
+    }
+}
+
+/// @brief Parse the trailing line and hand over the TimeSeries, which is
+/// moved out of the parser
+/// @returns The parsed TimeSeries
+TimeSeries CsvStreamParser::finish()
+{
+    if (m_json) {
+        throw ResponseError(classifyResponse(m_body),
+                            "'avapi::CsvStreamParser': Json Response:" +
+                                m_body);
+    }
+
+    if (!m_partial.empty()) {
+        parseLine(m_partial.data(), m_partial.data() + m_partial.size());
+        m_partial.clear();
+    }
+    return std::move(m_series);
+}
+
+/// @brief Parse one csv line (without its '\n') into a header or a TimePair
+/// @param begin: Start of the line
+/// @param end: One past the end of the line
+void CsvStreamParser::parseLine(const char *begin, const char *end)
+{
+    std::string_view line(begin, end - begin);
+    if (m_tokenizer.headerDone())
+        m_tokenizer.parseRow(line, m_series);
+    else
+        m_tokenizer.parseHeader(line, m_series);
+}
+
+} // namespace avapi
@@ -0,0 +1,545 @@
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <exception>
+#include <future>
+#include <limits>
+#include <stdexcept>
+#include "avapi/misc.hpp"
+#include "avapi/CsvTokenizer.hpp"
+#include "avapi/ThreadPool.hpp"
+
+namespace avapi {
+
+/// @brief CsvTokenizer constructor, keeping every column and reading
+/// timestamps as US/Eastern
+CsvTokenizer::CsvTokenizer() : CsvTokenizer(CsvProjection()) {}
+
+/// @brief CsvTokenizer constructor
+/// @param projection: The columns to keep
+/// @param zone: The time zone of the timestamps (default = US_EASTERN)
+CsvTokenizer::CsvTokenizer(const CsvProjection &projection,
+                           const TimeZone &zone)
+    : m_projection(projection), m_timestamps(zone)
+{
+}
+
+/// @brief Parse a complete csv body, header included
+/// @param data: The csv body
+/// @param resource: The memory resource the columns are drawn from
+/// (default = the default heap)
+/// @returns The parsed TimeSeries (without symbol, type or title set)
+TimeSeries CsvTokenizer::parse(std::string_view data,
+                               std::pmr::memory_resource *resource)
+{
+    TimeSeries series(resource);
+    size_t begin = skipHeader(data, series);
+    series.m_columns.resize(m_kept);
+
+    // Every line but the header is a row
+    size_t lines = countLines(data);
+    series.reserve(lines > 0 ? lines - 1 : 0);
+
+    if (begin < data.size())
+        parseBody(data.substr(begin), series);
+    return series;
+}
+
+/// @brief Parse a complete csv body into integer ticks, each cell read with
+/// FixedTimeSeries::toTicks() instead of as a double
+/// @param data: The csv body
+/// @param decimals: Decimal places of a tick (default = 4, use 8 for
+/// cryptocurrencies)
+/// @returns The parsed FixedTimeSeries (without symbol, type or title set)
+FixedTimeSeries CsvTokenizer::parseFixed(std::string_view data,
+                                         const unsigned &decimals)
+{
+    FixedTimeSeries fixed(decimals);
+    TimeSeries header;
+    size_t begin = skipHeader(data, header);
+    fixed.headers = header.headers;
+    fixed.m_columns.resize(m_kept);
+
+    size_t lines = countLines(data);
+    fixed.reserve(lines > 0 ? lines - 1 : 0);
+    if (begin >= data.size())
+        return fixed;
+
+    scanBody(data.substr(begin), [&](std::string_view line,
+                                     const uint32_t *commas,
+                                     const size_t &count,
+                                     const size_t &offset) {
+        size_t stamp = count > 0 ? commas[0] - offset : line.size();
+        fixed.m_timestamps.push_back(m_timestamps.parse(line.substr(0, stamp)));
+
+        // Short rows are padded with 0 to keep the columns aligned
+        for (size_t i = 0; i < m_columns.size(); ++i) {
+            size_t column = m_columns[i];
+            int64_t ticks = 0;
+            if (column <= count) {
+                size_t first = commas[column - 1] - offset + 1;
+                size_t last =
+                    column < count ? commas[column] - offset : line.size();
+                ticks = FixedTimeSeries::toTicks(
+                    line.substr(first, last - first), decimals);
+            }
+            fixed.m_columns[i].push_back(ticks);
+        }
+    });
+    return fixed;
+}
+
+/// @brief Parse a complete csv body into fixed width Schema::Row structs.
+/// The Schema's columns are looked up in the header once, every row is then
+/// read straight into its Row members.
+/// @param data: The csv body
+/// @returns The parsed Series (without symbol, type or title set)
+template <typename Schema>
+Series<Schema> CsvTokenizer::parseSeries(std::string_view data)
+{
+    constexpr size_t columns = Series<Schema>::COLUMNS;
+
+    Series<Schema> series;
+    TimeSeries header;
+    size_t begin = skipHeader(data, header);
+
+    // File column of every Schema column
+    std::vector<std::string_view> kept(header.headers.begin(),
+                                       header.headers.end());
+    std::array<size_t, columns> cells;
+    for (size_t i = 0; i < columns; ++i) {
+        std::vector<bool> match =
+            CsvProjection({Schema::names[i]}).select(kept);
+        auto found = std::find(match.begin() + 1, match.end(), true);
+        if (found == match.end()) {
+            throw std::invalid_argument(
+                std::string("avapi/CsvTokenizer.cpp: 'CsvTokenizer::"
+                            "parseSeries': no \"") +
+                Schema::names[i] + "\" column.");
+        }
+        cells[i] = m_columns[found - match.begin() - 1];
+    }
+
+    size_t lines = countLines(data);
+    series.reserve(lines > 0 ? lines - 1 : 0);
+    if (begin >= data.size())
+        return series;
+
+    std::array<std::string_view, columns> values;
+    scanBody(data.substr(begin), [&](std::string_view line,
+                                     const uint32_t *commas,
+                                     const size_t &count,
+                                     const size_t &offset) {
+        typename Schema::Row row;
+        size_t stamp = count > 0 ? commas[0] - offset : line.size();
+        row.timestamp = m_timestamps.parse(line.substr(0, stamp));
+
+        // Cells missing from short rows stay empty
+        for (size_t i = 0; i < columns; ++i) {
+            size_t column = cells[i];
+            values[i] = std::string_view();
+            if (column <= count) {
+                size_t first = commas[column - 1] - offset + 1;
+                size_t last =
+                    column < count ? commas[column] - offset : line.size();
+                values[i] = line.substr(first, last - first);
+            }
+        }
+        readFields<Schema>(row, values.data(),
+                           std::make_index_sequence<columns>());
+        series.pushBack(row);
+    });
+    return series;
+}
+
+/// @brief Parse a complete csv body on ThreadPool::cpu(). The rows are split
+/// into chunks at line boundaries, each chunk is parsed into its own buffer
+/// and the buffers are stitched together in the original row order.
+/// @param data: The csv body
+/// @param threads: Number of chunks (0 = one per ThreadPool::cpu() thread)
+/// @returns The parsed TimeSeries (without symbol, type or title set)
+TimeSeries CsvTokenizer::parseParallel(std::string_view data,
+                                       const size_t &threads)
+{
+    // Too little work to be worth splitting
+    const size_t min_chunk = 1024 * 1024;
+    size_t chunks = threads == 0 ? ThreadPool::cpu().size() : threads;
+    chunks = std::min(chunks, data.size() / min_chunk);
+    if (chunks <= 1)
+        return parse(data);
+
+    TimeSeries series;
+    size_t begin = skipHeader(data, series);
+    if (begin >= data.size())
+        return series;
+    std::string_view body = data.substr(begin);
+
+    // Move every cut forward to the start of the next line
+    std::vector<size_t> cuts = {0};
+    for (size_t i = 1; i < chunks; ++i) {
+        size_t target = std::max(cuts.back(), body.size() * i / chunks);
+        size_t cut = body.find('\n', target);
+        if (cut == std::string_view::npos || cut + 1 >= body.size())
+            break;
+        cuts.push_back(cut + 1);
+    }
+    cuts.push_back(body.size());
+
+    // Each chunk fills its own TimeSeries, stitched together below
+    std::vector<TimeSeries> results(cuts.size() - 1);
+    std::vector<std::future<void>> parts;
+    for (size_t i = 0; i + 1 < cuts.size(); ++i) {
+        std::string_view chunk = body.substr(cuts[i], cuts[i + 1] - cuts[i]);
+        TimeSeries *part = &results[i];
+        CsvTokenizer tokenizer = *this;
+        auto task = [tokenizer, chunk, part]() mutable {
+            part->m_columns.resize(tokenizer.m_kept);
+            part->reserve(countLines(chunk));
+            tokenizer.parseBody(chunk, *part);
+        };
+        parts.push_back(ThreadPool::cpu().submit(task));
+    }
+
+    // Wait for every chunk before rethrowing, tasks reference data
+    std::exception_ptr error;
+    for (auto &part : parts) {
+        try {
+            part.get();
+        }
+        catch (...) {
+            if (!error)
+                error = std::current_exception();
+        }
+    }
+    if (error)
+        std::rethrow_exception(error);
+
+    size_t rows = 0;
+    for (auto &part : results)
+        rows += part.rowCount();
+    series.m_columns.resize(m_kept);
+    series.reserve(rows);
+
+    // Each column is appended chunk after chunk
+    for (auto &part : results)
+        series.append(part);
+    return series;
+}
+
+/// @brief Parse the lines up to and including the header
+/// @param data: The csv body
+/// @param series: Receives the normalized column names
+/// @returns Offset of the first data line
+size_t CsvTokenizer::skipHeader(std::string_view data, TimeSeries &series)
+{
+    size_t begin = 0;
+    while (!m_headerDone && begin < data.size()) {
+        size_t end = data.find('\n', begin);
+        if (end == std::string_view::npos)
+            end = data.size();
+        parseHeader(data.substr(begin, end - begin), series);
+        begin = end + 1;
+    }
+    return begin;
+}
+
+/// @brief Parse the header line, deciding which columns are kept
+/// @param line: The header line
+/// @param series: Receives the normalized column names
+void CsvTokenizer::parseHeader(std::string_view line, TimeSeries &series)
+{
+    if (!line.empty() && line.back() == '\r')
+        line.remove_suffix(1);
+    if (line.empty())
+        return;
+
+    std::vector<std::string_view> cells;
+    size_t begin = 0;
+    while (true) {
+        size_t end = line.find(',', begin);
+        cells.push_back(line.substr(begin, end - begin));
+        if (end == std::string_view::npos)
+            break;
+        begin = end + 1;
+    }
+
+    m_keep = m_projection.select(cells);
+
+    series.headers.clear();
+    for (size_t i = 0; i < cells.size(); ++i) {
+        if (m_keep[i])
+            series.headers.push_back(normalizeHeader(std::string(cells[i])));
+    }
+    m_kept = series.headers.size() - 1;
+
+    // Cells right of the last kept column are never looked at. A TimeSeries
+    // is cut to the header's columns and pads short rows with NaN, only a
+    // single TimePair row keeps extra cells when there is no projection
+    m_last = m_keep.size() - 1;
+    while (m_last > 0 && !m_keep[m_last])
+        --m_last;
+    if (m_projection.keepsAll())
+        m_last = std::string_view::npos;
+
+    m_columns.clear();
+    for (size_t i = 1; i < m_keep.size(); ++i) {
+        if (m_keep[i])
+            m_columns.push_back(i);
+    }
+    m_headerDone = true;
+}
+
+/// @brief Parse one data line and append it to series
+/// @param line: The data line
+/// @param series: The TimeSeries to append to
+void CsvTokenizer::parseRow(std::string_view line, TimeSeries &series)
+{
+    parseBody(line, series);
+}
+
+/// @brief Parse one non empty data line into row
+/// @param line: The data line
+/// @param row: Receives the timestamp and the kept values
+void CsvTokenizer::parseRow(std::string_view line, TimePair &row)
+{
+    size_t count = m_scanner.scan(line);
+    if (!line.empty() && line.back() == '\r')
+        line.remove_suffix(1);
+    row.data.clear();
+    parseFields(line, m_scanner.index(), count, 0, row);
+}
+
+/// @brief Parse only the timestamp of a data line
+/// @param line: The data line
+std::time_t CsvTokenizer::parseTimestamp(std::string_view line)
+{
+    size_t comma = line.find(',');
+    if (comma == std::string_view::npos && !line.empty() &&
+        line.back() == '\r')
+        comma = line.size() - 1;
+    return m_timestamps.parse(line.substr(0, comma));
+}
+
+/// @brief Parse a single value of a data line, skipping the other cells
+/// @param line: The data line
+/// @param index: The value's index among the kept columns
+double CsvTokenizer::parseValue(std::string_view line, const size_t &index)
+{
+    size_t column = index + 1;
+    if (index < m_columns.size())
+        column = m_columns[index];
+    else if (!m_projection.keepsAll())
+        throw std::out_of_range("avapi/CsvTokenizer.cpp: 'CsvTokenizer::"
+                                "parseValue': column index out of range.");
+
+    if (!line.empty() && line.back() == '\r')
+        line.remove_suffix(1);
+    size_t begin = 0;
+    for (size_t i = 0; i < column; ++i) {
+        begin = line.find(',', begin);
+        if (begin == std::string_view::npos) {
+            throw std::out_of_range("avapi/CsvTokenizer.cpp: 'CsvTokenizer::"
+                                    "parseValue': row is too short.");
+        }
+        ++begin;
+    }
+    size_t end = std::min(line.find(',', begin), line.size());
+    return toDouble(line.substr(begin, end - begin));
+}
+
+/// @brief Walk the data lines of a body in blocks of whole lines, sized so
+/// the structural index stays in cache
+/// @param body: The data lines
+/// @param visit: Called as visit(line, commas, count, offset) for every non
+/// empty line, see parseFields()
+template <typename Visit>
+void CsvTokenizer::scanBody(std::string_view body, Visit &&visit)
+{
+    const size_t block_size = 64 * 1024;
+    size_t begin = 0;
+    while (begin < body.size()) {
+        size_t end = body.size();
+        if (end - begin > block_size) {
+            size_t cut = body.rfind('\n', begin + block_size - 1);
+            // A line longer than a block
+            if (cut == std::string_view::npos || cut < begin)
+                cut = body.find('\n', begin + block_size);
+            end = cut == std::string_view::npos ? body.size() : cut + 1;
+        }
+        scanBlock(body.substr(begin, end - begin), visit);
+        begin = end;
+    }
+}
+
+/// @brief Walk the data lines of one block off its structural index
+/// @param block: Whole data lines
+/// @param visit: Called for every non empty line
+template <typename Visit>
+void CsvTokenizer::scanBlock(std::string_view block, Visit &&visit)
+{
+    size_t count = m_scanner.scan(block);
+    const uint32_t *index = m_scanner.index();
+
+    size_t begin = 0;
+    size_t first = 0;
+    while (begin < block.size()) {
+        // index[first, last) are the line's commas, index[last] its '\n'
+        size_t last = first;
+        while (last < count && block[index[last]] != '\n')
+            ++last;
+        size_t end = last < count ? index[last] : block.size();
+
+        std::string_view line = block.substr(begin, end - begin);
+        if (!line.empty() && line.back() == '\r')
+            line.remove_suffix(1);
+        if (!line.empty())
+            visit(line, index + first, last - first, begin);
+        begin = end + 1;
+        first = last + 1;
+    }
+}
+
+/// @brief Parse the data lines of a body into series. Cells beyond the
+/// header are dropped and short rows are padded with NaN.
+/// @param body: The data lines
+/// @param series: The TimeSeries to append to
+void CsvTokenizer::parseBody(std::string_view body, TimeSeries &series)
+{
+    if (series.m_timestamps.empty() && series.m_columns.empty())
+        series.m_columns.resize(m_kept);
+    const size_t columns = std::min(series.m_columns.size(), m_columns.size());
+    const double missing = std::numeric_limits<double>::quiet_NaN();
+
+    // Cells go straight to the end of their column, short rows get NaN
+    scanBody(body, [&](std::string_view line, const uint32_t *commas,
+                       const size_t &count, const size_t &offset) {
+        size_t stamp = count > 0 ? commas[0] - offset : line.size();
+        series.m_timestamps.push_back(
+            m_timestamps.parse(line.substr(0, stamp)));
+
+        for (size_t i = 0; i < columns; ++i) {
+            size_t column = m_columns[i];
+            double value = missing;
+            if (column <= count) {
+                size_t first = commas[column - 1] - offset + 1;
+                size_t last =
+                    column < count ? commas[column] - offset : line.size();
+                value = toDouble(line.substr(first, last - first));
+            }
+            series.m_columns[i].push_back(value);
+        }
+        for (size_t i = columns; i < series.m_columns.size(); ++i)
+            series.m_columns[i].push_back(missing);
+    });
+}
+
+/// @brief Parse the cells of one non empty data line into row
+/// @param line: The data line, without '\r'
+/// @param commas: Offsets of the line's commas within the block
+/// @param count: Number of commas
+/// @param offset: Offset of the line within the block
+/// @param row: Receives the timestamp and the kept values
+void CsvTokenizer::parseFields(std::string_view line, const uint32_t *commas,
+                               const size_t &count, const size_t &offset,
+                               TimePair &row)
+{
+    size_t stamp = count > 0 ? commas[0] - offset : line.size();
+    row.timestamp = m_timestamps.parse(line.substr(0, stamp));
+    row.data.reserve(m_kept);
+
+    size_t columns = std::min(count, m_last);
+    for (size_t column = 1; column <= columns; ++column) {
+        if (column < m_keep.size() && !m_keep[column])
+            continue;
+
+        size_t begin = commas[column - 1] - offset + 1;
+        size_t end = column < count ? commas[column] - offset : line.size();
+        row.data.push_back(toDouble(line.substr(begin, end - begin)));
+    }
+}
+
+/// @brief Convert a cell to a number
+/// @param cell: The cell
+double CsvTokenizer::toDouble(std::string_view cell)
+{
+    double value = 0.0;
+    const char *first = cell.data();
+    const char *last = cell.data() + cell.size();
+    auto result = std::from_chars(first, last, value);
+    if (result.ec != std::errc() || result.ptr != last) {
+        throw std::invalid_argument(
+            "avapi/CsvTokenizer.cpp: 'CsvTokenizer::toDouble': \"" +
+            std::string(cell) + "\" is not a number.");
+    }
+    return value;
+}
+
+/// @brief Read a price cell, NaN if empty
+/// @param field: The Row member
+/// @param cell: The cell
+void CsvTokenizer::readCell(double &field, std::string_view cell)
+{
+    field = cell.empty() ? std::numeric_limits<double>::quiet_NaN()
+                         : toDouble(cell);
+}
+
+/// @brief Read a volume cell, 0 if empty
+/// @param field: The Row member
+/// @param cell: The cell
+/// @throws std::invalid_argument for trailing characters or a volume
+/// beyond int64_t
+void CsvTokenizer::readCell(int64_t &field, std::string_view cell)
+{
+    field = 0;
+    if (cell.empty())
+        return;
+
+    const char *first = cell.data();
+    const char *last = cell.data() + cell.size();
+    auto result = std::from_chars(first, last, field);
+    if (result.ec != std::errc() || result.ptr != last) {
+        throw std::invalid_argument(
+            "avapi/CsvTokenizer.cpp: 'CsvTokenizer::readCell': \"" +
+            std::string(cell) + "\" is not an integer.");
+    }
+}
+
+/// @brief Read the cells of a row into the Schema::fields members
+/// @param row: The Row
+/// @param cells: One cell per Schema column
+template <typename Schema, size_t... I>
+void CsvTokenizer::readFields(typename Schema::Row &row,
+                              const std::string_view *cells,
+                              std::index_sequence<I...>)
+{
+    (readCell(row.*std::get<I>(Schema::fields), cells[I]), ...);
+}
+
+/// @brief Test if a response is a JSON body (an Alpha Vantage error or
+/// notice) rather than csv
+/// @param data: The response body
+bool CsvTokenizer::isJson(std::string_view data)
+{
+    size_t start = data.find_first_not_of(" \t\r\n");
+    return start != std::string_view::npos && data[start] == '{';
+}
+
+/// @brief Count the lines of a buffer, a last line without '\n' included
+/// @param data: The buffer
+size_t CsvTokenizer::countLines(std::string_view data)
+{
+    size_t lines = std::count(data.begin(), data.end(), '\n');
+    if (!data.empty() && data.back() != '\n')
+        ++lines;
+    return lines;
+}
+
+// The Schemas of avapi/Container/Series.hpp
+template Series<OHLCV> CsvTokenizer::parseSeries(std::string_view data);
+template Series<AdjustedDaily>
+CsvTokenizer::parseSeries(std::string_view data);
+template Series<AdjustedWeekly>
+CsvTokenizer::parseSeries(std::string_view data);
+template Series<CryptoOHLCV> CsvTokenizer::parseSeries(std::string_view data);
+
+} // namespace avapi
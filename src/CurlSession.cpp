@@ -0,0 +1,286 @@
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <curl/curl.h>
+#include "avapi/CurlSession.hpp"
+
+namespace avapi {
+
+/// @brief Return the process wide CurlSession, created on first use
+CurlSession &CurlSession::instance()
+{
+    static CurlSession session;
+    return session;
+}
+
+/// @brief   CurlSession constructor, initializes libcurl exactly once
+CurlSession::CurlSession() { curl_global_init(CURL_GLOBAL_DEFAULT); }
+
+/// @brief   CurlSession deconstructor, releases pooled handles and libcurl
+CurlSession::~CurlSession()
+{
+    for (auto handle : m_idle) {
+        curl_easy_cleanup(static_cast<CURL *>(handle));
+    }
+    m_idle.clear();
+    curl_global_cleanup();
+}
+
+/// @brief   GET a url using a pooled easy handle
+/// @param   url The API query URL to be curled
+/// @returns The response body as an std::string
+std::string CurlSession::perform(const std::string &url)
+{
+    CURL *curl = static_cast<CURL *>(acquireHandle());
+    std::string data;
+
+    curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteMemoryCallback);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &data);
+    CURLcode res = curl_easy_perform(curl);
+
+    recordTransfer(curl, res == CURLE_OK);
+    releaseHandle(curl);
+
+    if (res != CURLE_OK) {
+        throw std::runtime_error(
+            std::string("avapi/CurlSession.cpp: 'CurlSession::perform': ") +
+            curl_easy_strerror(res));
+    }
+    return data;
+}
+
+/// @brief   GET a url, handing each chunk to on_chunk as soon as libcurl
+/// delivers it instead of buffering the whole response
+/// @param   url The API query URL to be curled
+/// @param   on_chunk Called for every received chunk, may throw to abort
+void CurlSession::perform(const std::string &url, const ChunkCallback &on_chunk)
+{
+    ChunkSink sink{&on_chunk, nullptr};
+
+    CURL *curl = static_cast<CURL *>(acquireHandle());
+    curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteChunkCallback);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &sink);
+    CURLcode res = curl_easy_perform(curl);
+
+    recordTransfer(curl, res == CURLE_OK);
+    releaseHandle(curl);
+
+    // An exception thrown by on_chunk aborted the transfer, pass it on
+    if (sink.error)
+        std::rethrow_exception(sink.error);
+
+    if (res != CURLE_OK) {
+        throw std::runtime_error(
+            std::string("avapi/CurlSession.cpp: 'CurlSession::perform': ") +
+            curl_easy_strerror(res));
+    }
+}
+
+/// @brief   GET several urls concurrently through one curl multi handle
+/// @param   urls The API query URLs to be curled
+/// @param   max_concurrent Maximum number of transfers in flight at once
+/// @param   on_complete Called once per url, in completion order, with the
+/// url's index, its body and an error message (empty on success). Must not
+/// throw.
+/// @param   admit Optional gate asked before each transfer starts, a refused
+/// transfer is asked again shortly after
+void CurlSession::performMulti(const std::vector<std::string> &urls,
+                               const size_t &max_concurrent,
+                               const MultiCallback &on_complete,
+                               const AdmitCallback &admit)
+{
+    struct Transfer {
+        size_t index;
+        std::string data;
+    };
+
+    CURLM *multi = curl_multi_init();
+    if (multi == nullptr) {
+        throw std::runtime_error("avapi/CurlSession.cpp: "
+                                 "'CurlSession::performMulti': "
+                                 "curl_multi_init() failed.");
+    }
+
+    size_t limit = max_concurrent == 0 ? 1 : max_concurrent;
+    curl_multi_setopt(multi, CURLMOPT_MAX_HOST_CONNECTIONS,
+                      static_cast<long>(limit));
+
+    std::vector<std::unique_ptr<Transfer>> transfers(urls.size());
+    size_t next = 0;
+    size_t in_flight = 0;
+    int running = 0;
+
+    do {
+        // Keep up to 'limit' transfers attached to the multi handle
+        bool admitted = true;
+        while (next < urls.size() && in_flight < limit) {
+            if (admit && !admit(next)) {
+                admitted = false;
+                break;
+            }
+            transfers[next].reset(new Transfer{next, ""});
+            CURL *curl = static_cast<CURL *>(acquireHandle());
+            curl_easy_setopt(curl, CURLOPT_URL, urls[next].c_str());
+            curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteMemoryCallback);
+            curl_easy_setopt(curl, CURLOPT_WRITEDATA, &transfers[next]->data);
+            curl_easy_setopt(curl, CURLOPT_PRIVATE, transfers[next].get());
+            curl_multi_add_handle(multi, curl);
+            ++next;
+            ++in_flight;
+        }
+
+        curl_multi_perform(multi, &running);
+
+        // Hand off every finished transfer before waiting for more
+        int queued = 0;
+        while (CURLMsg *msg = curl_multi_info_read(multi, &queued)) {
+            if (msg->msg != CURLMSG_DONE)
+                continue;
+
+            CURL *curl = msg->easy_handle;
+            CURLcode res = msg->data.result;
+            Transfer *transfer = nullptr;
+            curl_easy_getinfo(curl, CURLINFO_PRIVATE, &transfer);
+
+            curl_multi_remove_handle(multi, curl);
+            recordTransfer(curl, res == CURLE_OK);
+            releaseHandle(curl);
+            --in_flight;
+
+            std::string error = res == CURLE_OK ? "" : curl_easy_strerror(res);
+            on_complete(transfer->index, transfer->data, error);
+            transfers[transfer->index].reset();
+        }
+
+        int timeout_ms = admitted ? 1000 : 100;
+        if (running > 0)
+            curl_multi_wait(multi, nullptr, 0, timeout_ms, nullptr);
+        else if (!admitted)
+            std::this_thread::sleep_for(std::chrono::milliseconds(timeout_ms));
+
+    } while (in_flight > 0 || next < urls.size());
+
+    curl_multi_cleanup(multi);
+}
+
+/// @brief   Update the connection reuse counters after a finished transfer
+/// @param   handle The easy handle that performed the transfer
+/// @param   ok Whether the transfer succeeded
+void CurlSession::recordTransfer(void *handle, const bool &ok)
+{
+    // Zero new connections means the request rode on a cached connection
+    long connects = 0;
+    curl_easy_getinfo(static_cast<CURL *>(handle), CURLINFO_NUM_CONNECTS,
+                      &connects);
+    ++m_requests;
+    if (connects > 0)
+        m_newConnections += static_cast<size_t>(connects);
+    else if (ok)
+        ++m_reusedConnections;
+}
+
+/// @brief   Get a snapshot of the connection reuse counters
+ConnectionStats CurlSession::stats() const
+{
+    ConnectionStats stats;
+    stats.requests = m_requests;
+    stats.new_connections = m_newConnections;
+    stats.reused_connections = m_reusedConnections;
+    return stats;
+}
+
+/// @brief   Reset the connection reuse counters
+void CurlSession::resetStats()
+{
+    m_requests = 0;
+    m_newConnections = 0;
+    m_reusedConnections = 0;
+}
+
+/// @brief   Take an idle easy handle from the pool, or create a new one
+void *CurlSession::acquireHandle()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_idle.empty()) {
+            void *handle = m_idle.back();
+            m_idle.pop_back();
+            return handle;
+        }
+    }
+
+    CURL *curl = curl_easy_init();
+    if (curl == nullptr) {
+        throw std::runtime_error("avapi/CurlSession.cpp: "
+                                 "'CurlSession::acquireHandle': "
+                                 "curl_easy_init() failed.");
+    }
+
+    // Options that survive across requests on this handle
+    curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
+    curl_easy_setopt(curl, CURLOPT_TCP_KEEPIDLE, 60L);
+    curl_easy_setopt(curl, CURLOPT_TCP_KEEPINTVL, 30L);
+    curl_easy_setopt(curl, CURLOPT_ACCEPT_ENCODING, "");
+    return curl;
+}
+
+/// @brief   Return an easy handle to the pool, keeping its connection cache
+void CurlSession::releaseHandle(void *handle)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_idle.size() < m_maxIdle) {
+            m_idle.push_back(handle);
+            return;
+        }
+    }
+    curl_easy_cleanup(static_cast<CURL *>(handle));
+}
+
+/// @brief   Callback function for CURLOPT_WRITEFUNCTION
+/// @param   ptr The downloaded chunk members
+/// @param   size Member memory size
+/// @param   nmemb Number of members
+/// @param   data Current running chunk for data appension
+/// @returns The current running chunk's realsize
+size_t CurlSession::WriteMemoryCallback(void *ptr, size_t size, size_t nmemb,
+                                        void *data)
+{
+    size_t realsize = size * nmemb;
+
+    std::string *mem = reinterpret_cast<std::string *>(data);
+    mem->append(static_cast<char *>(ptr), realsize);
+    return realsize;
+}
+
+/// @brief   Callback function for CURLOPT_WRITEFUNCTION when streaming
+/// @param   ptr The downloaded chunk members
+/// @param   size Member memory size
+/// @param   nmemb Number of members
+/// @param   data The ChunkSink holding the user's ChunkCallback
+/// @returns The chunk's realsize, or 0 to abort after an exception
+size_t CurlSession::WriteChunkCallback(void *ptr, size_t size, size_t nmemb,
+                                       void *data)
+{
+    size_t realsize = size * nmemb;
+    ChunkSink *sink = reinterpret_cast<ChunkSink *>(data);
+
+    // Exceptions must not unwind through libcurl
+    try {
+        (*sink->on_chunk)(static_cast<char *>(ptr), realsize);
+    }
+    catch (...) {
+        sink->error = std::current_exception();
+        return 0;
+    }
+    return realsize;
+}
+
+/// @brief Maximum number of idle easy handles kept in the pool
+const size_t CurlSession::m_maxIdle = 16;
+
+} // namespace avapi
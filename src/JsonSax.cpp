@@ -0,0 +1,297 @@
+#include <array>
+#include <charconv>
+#include <stdexcept>
+#include <nlohmann/json.hpp>
+#include "avapi/misc.hpp"
+#include "avapi/JsonSax.hpp"
+
+namespace avapi {
+
+/// @brief Event handler base for nlohmann::json::sax_parse(). It tracks the
+/// nesting depth, the current top level key (the section) and the current
+/// key, and hands string values and opened objects to the derived parser.
+class SaxHandler {
+public:
+    using json = nlohmann::json;
+
+    virtual ~SaxHandler() = default;
+
+    bool null() { return true; }
+    bool boolean(bool) { return true; }
+    bool number_integer(json::number_integer_t) { return true; }
+    bool number_unsigned(json::number_unsigned_t) { return true; }
+    bool number_float(json::number_float_t, const json::string_t &)
+    {
+        return true;
+    }
+    template <typename Binary> bool binary(Binary &) { return true; }
+
+    bool string(json::string_t &value)
+    {
+        onString(value);
+        return true;
+    }
+
+    bool key(json::string_t &key)
+    {
+        m_key = key;
+        if (m_depth == 1)
+            m_section = key;
+        return true;
+    }
+
+    bool start_object(std::size_t)
+    {
+        ++m_depth;
+        onObject();
+        return true;
+    }
+    bool end_object()
+    {
+        --m_depth;
+        return true;
+    }
+    bool start_array(std::size_t)
+    {
+        ++m_depth;
+        return true;
+    }
+    bool end_array()
+    {
+        --m_depth;
+        return true;
+    }
+
+    // Rethrown as its own type, e.g. json::parse_error, not sliced
+    template <typename Exception>
+    bool parse_error(std::size_t, const std::string &, const Exception &ex)
+    {
+        throw ex;
+    }
+
+protected:
+    // A string value, the parser's buffer may be moved from
+    virtual void onString(std::string &) {}
+    // An object was opened, m_depth already counts it
+    virtual void onObject() {}
+
+    size_t m_depth = 0;
+    std::string m_section;
+    std::string m_key;
+};
+
+/// @brief Run a SaxHandler over a body
+static void saxParse(std::string_view data, SaxHandler &handler)
+{
+    nlohmann::json::sax_parse(data.begin(), data.end(), &handler);
+}
+
+/// @brief EARNINGS: {"annualEarnings": [{...}], "quarterlyEarnings": [{...}]}
+class EarningsHandler : public SaxHandler {
+public:
+    EarningsHandler(AnnualEarnings &annual, QuarterlyEarnings &quarterly)
+        : m_annual(annual), m_quarterly(quarterly)
+    {
+    }
+
+protected:
+    void onObject() override
+    {
+        // Reports are the objects inside the two arrays
+        m_report = Report::NONE;
+        if (m_depth != 3)
+            return;
+        if (m_section == "annualEarnings") {
+            m_annual.data.emplace_back();
+            m_report = Report::ANNUAL;
+        }
+        else if (m_section == "quarterlyEarnings") {
+            m_quarterly.data.emplace_back();
+            m_report = Report::QUARTERLY;
+        }
+    }
+
+    void onString(std::string &value) override
+    {
+        if (m_depth != 3 || m_report == Report::NONE)
+            return;
+
+        if (m_report == Report::ANNUAL) {
+            auto &report = m_annual.data.back();
+            if (m_key == "fiscalDateEnding")
+                report.fiscal_date_ending = std::move(value);
+            else if (m_key == "reportedEPS")
+                report.reported_eps = std::move(value);
+            return;
+        }
+
+        auto &report = m_quarterly.data.back();
+        if (m_key == "fiscalDateEnding")
+            report.fiscal_date_ending = std::move(value);
+        else if (m_key == "reportedDate")
+            report.reported_date = std::move(value);
+        else if (m_key == "reportedEPS")
+            report.reported_eps = std::move(value);
+        else if (m_key == "estimatedEPS")
+            report.estimated_eps = std::move(value);
+        else if (m_key == "surprise")
+            report.surprise = std::move(value);
+        else if (m_key == "surprisePercentage")
+            report.surprise_percentage = std::move(value);
+    }
+
+private:
+    enum class Report { NONE, ANNUAL, QUARTERLY };
+
+    AnnualEarnings &m_annual;
+    QuarterlyEarnings &m_quarterly;
+    Report m_report = Report::NONE;
+};
+
+/// @brief OVERVIEW: one flat object of strings
+class OverviewHandler : public SaxHandler {
+public:
+    explicit OverviewHandler(
+        std::unordered_map<std::string, std::string> &fields)
+        : m_fields(fields)
+    {
+    }
+
+protected:
+    void onString(std::string &value) override
+    {
+        if (m_depth == 1)
+            m_fields.emplace(m_key, std::move(value));
+    }
+
+private:
+    std::unordered_map<std::string, std::string> &m_fields;
+};
+
+/// @brief A single nested object of numbered fields, as in CRYPTO_RATING's
+/// "Crypto Rating (FCAS)" and CURRENCY_EXCHANGE_RATE's "Realtime Currency
+/// Exchange Rate". Values are stored by their field number.
+template <size_t N> class NumberedHandler : public SaxHandler {
+public:
+    explicit NumberedHandler(const std::string &section) : m_name(section) {}
+
+    std::array<std::string, N> fields;
+    bool found = false;
+
+protected:
+    void onString(std::string &value) override
+    {
+        if (m_depth != 2 || m_section != m_name)
+            return;
+        // "5. Exchange Rate" -> 5
+        size_t number = 0;
+        for (char c : m_key) {
+            if (c < '0' || c > '9')
+                break;
+            number = number * 10 + static_cast<size_t>(c - '0');
+        }
+        if (number >= 1 && number <= N) {
+            fields[number - 1] = std::move(value);
+            found = true;
+        }
+    }
+
+private:
+    std::string m_name;
+};
+
+/// @brief Parse an EARNINGS response
+/// @param data: The JSON body
+/// @param annual: Receives the annual reports, replacing its data
+/// @param quarterly: Receives the quarterly reports, replacing its data
+void parseEarnings(std::string_view data, AnnualEarnings &annual,
+                   QuarterlyEarnings &quarterly)
+{
+    annual.data.clear();
+    quarterly.data.clear();
+    EarningsHandler handler(annual, quarterly);
+    saxParse(data, handler);
+}
+
+/// @brief Parse an OVERVIEW response
+/// @param data: The JSON body
+/// @param fields: Receives every top level string, replacing its contents
+void parseOverview(std::string_view data,
+                   std::unordered_map<std::string, std::string> &fields)
+{
+    fields.clear();
+    OverviewHandler handler(fields);
+    saxParse(data, handler);
+}
+
+/// @brief Parse a CRYPTO_RATING response
+/// @param data: The JSON body
+/// @param fields: Receives [symbol, name, fcas rating, fcas score, developer
+/// score, market maturity score, utility score, timezone]
+/// @param timestamp: Receives the last refreshed time
+void parseHealthIndex(std::string_view data, std::vector<std::string> &fields,
+                      std::time_t &timestamp)
+{
+    NumberedHandler<9> handler("Crypto Rating (FCAS)");
+    saxParse(data, handler);
+    if (!handler.found) {
+        throw std::runtime_error("avapi/JsonSax.cpp: 'parseHealthIndex': "
+                                 "no \"Crypto Rating (FCAS)\" in response: " +
+                                 std::string(data));
+    }
+
+    // "8. last refreshed" becomes the timestamp
+    fields.clear();
+    for (size_t i = 0; i < 9; ++i) {
+        if (i != 7)
+            fields.push_back(std::move(handler.fields[i]));
+    }
+    timestamp = toUnixTimestamp(handler.fields[7], TimeZone::UTC);
+}
+
+/// @brief Parse a CURRENCY_EXCHANGE_RATE response
+/// @param data: The JSON body
+/// @param from: The symbol exchanged from
+/// @param to: The symbol exchanged to
+ExchangeRate parseExchangeRate(std::string_view data, const std::string &from,
+                               const std::string &to)
+{
+    NumberedHandler<9> handler("Realtime Currency Exchange Rate");
+    saxParse(data, handler);
+    if (!handler.found) {
+        throw std::runtime_error(
+            "avapi/JsonSax.cpp: 'parseExchangeRate': no \"Realtime Currency "
+            "Exchange Rate\" in response: " +
+            std::string(data));
+    }
+
+    // "5. Exchange Rate", "6. Last Refreshed", "8. Bid Price", "9. Ask Price"
+    for (size_t i : {4, 5, 7, 8}) {
+        if (handler.fields[i].empty()) {
+            throw std::runtime_error(
+                "avapi/JsonSax.cpp: 'parseExchangeRate': field " +
+                std::to_string(i + 1) + " missing from response: " +
+                std::string(data));
+        }
+    }
+
+    std::time_t timestamp = toUnixTimestamp(handler.fields[5], TimeZone::UTC);
+    std::vector<double> rates;
+    for (size_t i : {4, 7, 8}) {
+        double rate = 0;
+        const std::string &field = handler.fields[i];
+        auto result =
+            std::from_chars(field.data(), field.data() + field.size(), rate);
+        if (result.ec != std::errc() ||
+            result.ptr != field.data() + field.size()) {
+            throw std::runtime_error(
+                "avapi/JsonSax.cpp: 'parseExchangeRate': field " +
+                std::to_string(i + 1) + " is not a number: \"" + field +
+                "\"");
+        }
+        rates.push_back(rate);
+    }
+    return {from, to, timestamp, rates};
+}
+
+} // namespace avapi
@@ -0,0 +1,111 @@
+#include <stdexcept>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include "avapi/MappedFile.hpp"
+
+namespace avapi {
+
+/// @brief Build the exception thrown when a file cannot be mapped
+static std::runtime_error mapError(const std::string &path)
+{
+    return std::runtime_error("avapi/MappedFile.cpp: 'MappedFile': \"" + path +
+                              "\" cannot be mapped");
+}
+
+#ifdef _WIN32
+
+/// @brief Map a file into memory
+/// @param path: The file's path
+MappedFile::MappedFile(const std::string &path)
+{
+    m_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                         OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (m_file == INVALID_HANDLE_VALUE) {
+        m_file = nullptr;
+        throw mapError(path);
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(m_file, &size)) {
+        CloseHandle(m_file);
+        throw mapError(path);
+    }
+    m_size = static_cast<size_t>(size.QuadPart);
+    if (m_size == 0)
+        return;
+
+    m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0,
+                                   nullptr);
+    if (m_mapping == nullptr) {
+        CloseHandle(m_file);
+        throw mapError(path);
+    }
+
+    m_data = static_cast<const char *>(
+        MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+    if (m_data == nullptr) {
+        CloseHandle(m_mapping);
+        CloseHandle(m_file);
+        throw mapError(path);
+    }
+}
+
+/// @brief Unmap the file
+MappedFile::~MappedFile()
+{
+    if (m_data != nullptr)
+        UnmapViewOfFile(m_data);
+    if (m_mapping != nullptr)
+        CloseHandle(m_mapping);
+    if (m_file != nullptr)
+        CloseHandle(m_file);
+}
+
+#else
+
+/// @brief Map a file into memory
+/// @param path: The file's path
+MappedFile::MappedFile(const std::string &path)
+{
+    m_fd = open(path.c_str(), O_RDONLY);
+    if (m_fd < 0)
+        throw mapError(path);
+
+    struct stat info;
+    if (fstat(m_fd, &info) != 0) {
+        close(m_fd);
+        throw mapError(path);
+    }
+    m_size = static_cast<size_t>(info.st_size);
+    if (m_size == 0)
+        return;
+
+    void *data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_fd, 0);
+    if (data == MAP_FAILED) {
+        close(m_fd);
+        throw mapError(path);
+    }
+    madvise(data, m_size, MADV_SEQUENTIAL);
+    m_data = static_cast<const char *>(data);
+}
+
+/// @brief Unmap the file
+MappedFile::~MappedFile()
+{
+    if (m_data != nullptr)
+        munmap(const_cast<char *>(m_data), m_size);
+    if (m_fd >= 0)
+        close(m_fd);
+}
+
+#endif
+
+} // namespace avapi
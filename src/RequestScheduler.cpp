@@ -0,0 +1,203 @@
+#include <algorithm>
+#include "avapi/RequestScheduler.hpp"
+#include "avapi/ResponseStatus.hpp"
+
+namespace avapi {
+
+/// @brief Return the process wide RequestScheduler, created on first use
+RequestScheduler &RequestScheduler::instance()
+{
+    static RequestScheduler scheduler;
+    return scheduler;
+}
+
+/// @brief RequestScheduler constructor, defaults to the free Alpha Vantage
+/// key quota of 5 calls per minute
+RequestScheduler::RequestScheduler()
+    : m_ratePerSecond(5.0 / 60.0), m_capacity(5.0), m_tokens(5.0),
+      m_lastRefill(Clock::now()), m_pausedUntil(Clock::now()),
+      m_cooldown(15000), m_maxRetries(2)
+{
+}
+
+/// @brief Configure the token bucket
+/// @param calls_per_minute: Sustained request rate (0 = unlimited)
+/// @param burst: Maximum number of requests that may be sent back to back
+void RequestScheduler::setRate(const double &calls_per_minute,
+                               const size_t &burst)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_ratePerSecond = calls_per_minute / 60.0;
+    m_capacity = static_cast<double>(std::max<size_t>(burst, 1));
+    m_tokens = std::min(m_tokens, m_capacity);
+    m_factor = 1.0;
+    m_cv.notify_all();
+}
+
+/// @brief Set how long requests are held back after a throttle response
+/// @param cooldown: Pause length
+void RequestScheduler::setCooldown(const std::chrono::milliseconds &cooldown)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_cooldown = cooldown;
+}
+
+/// @brief Set how many times a throttled request is sent again
+/// @param retries: Number of retries
+void RequestScheduler::setMaxRetries(const size_t &retries)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_maxRetries = retries;
+}
+
+/// @brief Get how many times a throttled request is sent again
+size_t RequestScheduler::maxRetries()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_maxRetries;
+}
+
+/// @brief Block until a request of the given priority may be sent
+/// @param priority: The request's avapi::Priority
+void RequestScheduler::acquire(const Priority &priority)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_ratePerSecond <= 0.0) {
+        ++m_stats.granted;
+        return;
+    }
+
+    Ticket ticket{priority, m_nextSequence++};
+    m_waiting.push(ticket);
+
+    while (true) {
+        Clock::time_point now = Clock::now();
+        refill(now);
+
+        bool first = m_waiting.top().sequence == ticket.sequence;
+        bool unlimited = m_ratePerSecond <= 0.0;
+        bool ready = now >= m_pausedUntil && m_tokens >= 1.0;
+        if (first && (unlimited || ready)) {
+            if (!unlimited)
+                m_tokens -= 1.0;
+            m_waiting.pop();
+            ++m_stats.granted;
+            m_cv.notify_all();
+            return;
+        }
+
+        // Only the head of the queue needs to wake up for the next token
+        if (first)
+            m_cv.wait_until(lock, nextTokenTime(now));
+        else
+            m_cv.wait(lock);
+    }
+}
+
+/// @brief Take a token without blocking. Fails while a request of equal or
+/// higher priority is already waiting.
+/// @param priority: The request's avapi::Priority
+/// @returns true if the request may be sent now
+bool RequestScheduler::tryAcquire(const Priority &priority)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_ratePerSecond <= 0.0) {
+        ++m_stats.granted;
+        return true;
+    }
+
+    Clock::time_point now = Clock::now();
+    refill(now);
+
+    if (now < m_pausedUntil || m_tokens < 1.0)
+        return false;
+    if (!m_waiting.empty() && m_waiting.top().priority <= priority)
+        return false;
+
+    m_tokens -= 1.0;
+    ++m_stats.granted;
+    return true;
+}
+
+/// @brief Get the time left until the next token is available
+RequestScheduler::Clock::duration RequestScheduler::timeUntilToken()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_ratePerSecond <= 0.0)
+        return Clock::duration::zero();
+
+    Clock::time_point now = Clock::now();
+    refill(now);
+    return std::max(nextTokenTime(now) - now, Clock::duration::zero());
+}
+
+/// @brief Report an accepted response, gradually restoring the full rate
+void RequestScheduler::onSuccess()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_factor = std::min(1.0, m_factor + 0.1);
+}
+
+/// @brief Report an in-band throttle response. Halves the effective rate,
+/// empties the bucket and pauses all requests for the cooldown.
+void RequestScheduler::onThrottled()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Clock::time_point now = Clock::now();
+    refill(now);
+
+    m_factor = std::max(0.1, m_factor * 0.5);
+    m_tokens = 0.0;
+    m_pausedUntil = std::max(m_pausedUntil, now + m_cooldown);
+    ++m_stats.throttled;
+    m_cv.notify_all();
+}
+
+/// @brief Test if a response is Alpha Vantage's call frequency notice
+/// @param data: The response body
+bool RequestScheduler::isThrottled(const std::string &data)
+{
+    return classifyResponse(data).error == ApiError::RATE_LIMITED;
+}
+
+/// @brief Get a snapshot of the scheduler counters
+SchedulerStats RequestScheduler::stats()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+/// @brief Add the tokens earned since the last refill
+/// @param now: The current time
+void RequestScheduler::refill(const Clock::time_point &now)
+{
+    std::chrono::duration<double> elapsed = now - m_lastRefill;
+    m_lastRefill = now;
+    m_tokens = std::min(m_capacity, m_tokens + elapsed.count() *
+                                                   m_ratePerSecond * m_factor);
+}
+
+/// @brief Get the point in time at which one full token is available
+/// @param now: The current time
+RequestScheduler::Clock::time_point
+RequestScheduler::nextTokenTime(const Clock::time_point &now)
+{
+    Clock::time_point ready = now;
+    if (m_tokens < 1.0) {
+        std::chrono::duration<double> wait(
+            (1.0 - m_tokens) / (m_ratePerSecond * m_factor));
+        ready += std::chrono::duration_cast<Clock::duration>(wait);
+    }
+    return std::max(ready, m_pausedUntil);
+}
+
+/// @brief Lower Priority values first, then lower sequence numbers
+bool RequestScheduler::TicketOrder::operator()(const Ticket &a,
+                                               const Ticket &b) const
+{
+    if (a.priority != b.priority)
+        return a.priority > b.priority;
+    return a.sequence > b.sequence;
+}
+
+} // namespace avapi
@@ -0,0 +1,286 @@
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+#include "avapi/ResponseCache.hpp"
+#include "avapi/ResponseStatus.hpp"
+
+namespace fs = std::filesystem;
+
+namespace avapi {
+
+/// @brief Return the process wide ResponseCache, created on first use
+ResponseCache &ResponseCache::instance()
+{
+    static ResponseCache cache;
+    return cache;
+}
+
+/// @brief ResponseCache constructor, sets the default time to live of each
+/// cacheable Alpha Vantage FUNCTION
+ResponseCache::ResponseCache() : m_maxBytes(256ull * 1024 * 1024)
+{
+    using std::chrono::hours;
+    using std::chrono::seconds;
+
+    // Company fundamentals change at most daily
+    m_ttl["OVERVIEW"] = hours(24);
+    m_ttl["EARNINGS"] = hours(24);
+    m_ttl["CRYPTO_RATING"] = hours(24);
+
+    // The latest bar of a series keeps moving during the trading day
+    m_ttl["TIME_SERIES_INTRADAY"] = seconds(60);
+    m_ttl["TIME_SERIES_DAILY"] = hours(1);
+    m_ttl["TIME_SERIES_DAILY_ADJUSTED"] = hours(1);
+    m_ttl["TIME_SERIES_WEEKLY"] = hours(1);
+    m_ttl["TIME_SERIES_WEEKLY_ADJUSTED"] = hours(1);
+    m_ttl["TIME_SERIES_MONTHLY"] = hours(1);
+    m_ttl["TIME_SERIES_MONTHLY_ADJUSTED"] = hours(1);
+    m_ttl["DIGITAL_CURRENCY_DAILY"] = hours(1);
+    m_ttl["DIGITAL_CURRENCY_WEEKLY"] = hours(1);
+    m_ttl["DIGITAL_CURRENCY_MONTHLY"] = hours(1);
+
+    // GLOBAL_QUOTE and CURRENCY_EXCHANGE_RATE are live data, never cached
+}
+
+/// @brief Set the cache directory, creating it if needed
+/// @param path: The directory to store responses in ("" disables the cache)
+void ResponseCache::setDirectory(const std::string &path)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_directory = path;
+    m_totalBytes = 0;
+    if (path == "")
+        return;
+
+    fs::create_directories(path);
+    for (auto &entry : fs::directory_iterator(path)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".cache")
+            m_totalBytes += entry.file_size();
+    }
+    if (m_totalBytes > m_maxBytes)
+        evict();
+}
+
+/// @brief Whether a cache directory has been set
+bool ResponseCache::enabled()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_directory != "";
+}
+
+/// @brief Set the size the cache directory is kept under
+/// @param bytes: Maximum total size of all entries
+void ResponseCache::setMaxBytes(const std::uintmax_t &bytes)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_maxBytes = bytes;
+    if (m_directory != "" && m_totalBytes > m_maxBytes)
+        evict();
+}
+
+/// @brief Set the time to live of a FUNCTION's responses
+/// @param function: Alpha Vantage FUNCTION e.g. "OVERVIEW"
+/// @param ttl: Time to live (0 = never cache)
+void ResponseCache::setTtl(const std::string &function,
+                           const std::chrono::seconds &ttl)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_ttl[function] = ttl;
+}
+
+/// @brief Get the time to live of a FUNCTION's responses
+/// @param function: Alpha Vantage FUNCTION e.g. "OVERVIEW"
+std::chrono::seconds ResponseCache::ttl(const std::string &function)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_ttl.find(function);
+    return it == m_ttl.end() ? std::chrono::seconds(0) : it->second;
+}
+
+/// @brief Look up a fresh response
+/// @param key: The canonical query
+/// @param function: The query's Alpha Vantage FUNCTION
+/// @param data: Set to the cached response on a hit
+/// @returns true on a hit
+bool ResponseCache::get(const std::string &key, const std::string &function,
+                        std::string &data)
+{
+    std::string path;
+    std::chrono::seconds time_to_live = ttl(function);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_directory == "" || time_to_live.count() <= 0)
+            return false;
+        path = entryPath(key);
+    }
+
+    bool hit = false;
+    std::error_code ec;
+    fs::file_time_type written = fs::last_write_time(path, ec);
+
+    if (!ec && fs::file_time_type::clock::now() - written < time_to_live) {
+        std::ifstream file(path, std::ios::binary);
+        std::string stored_key;
+
+        // The first line holds the full key, guarding against hash collisions
+        if (file && std::getline(file, stored_key) && stored_key == key) {
+            std::streampos begin = file.tellg();
+            file.seekg(0, std::ios::end);
+            std::streamoff size = file.tellg() - begin;
+            file.seekg(begin);
+
+            data.resize(static_cast<size_t>(size));
+            file.read(&data[0], size);
+            hit = static_cast<bool>(file);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (hit)
+        ++m_stats.hits;
+    else
+        ++m_stats.misses;
+    return hit;
+}
+
+/// @brief Store a response. The entry is written to a temporary file and
+/// renamed into place so readers never see a partial entry.
+/// @param key: The canonical query
+/// @param function: The query's Alpha Vantage FUNCTION
+/// @param data: The response body
+void ResponseCache::put(const std::string &key, const std::string &function,
+                        const std::string &data)
+{
+    std::string path;
+    std::string temp;
+    std::chrono::seconds time_to_live = ttl(function);
+    auto ticks = std::chrono::steady_clock::now().time_since_epoch().count();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_directory == "" || time_to_live.count() <= 0)
+            return;
+        path = entryPath(key);
+        temp = path + ".tmp" + std::to_string(ticks) + "_" +
+               std::to_string(m_tempCounter++);
+    }
+
+    {
+        std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+        file << key << '\n';
+        file.write(data.data(), data.size());
+        if (!file) {
+            file.close();
+            std::remove(temp.c_str());
+            return;
+        }
+    }
+
+    std::error_code ec;
+    std::uintmax_t replaced = fs::file_size(path, ec);
+    if (ec)
+        replaced = 0;
+
+    fs::rename(temp, path, ec);
+    if (ec) {
+        fs::remove(temp, ec);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_totalBytes += key.size() + 1 + data.size();
+    m_totalBytes -= std::min(replaced, m_totalBytes);
+    ++m_stats.stores;
+    if (m_totalBytes > m_maxBytes)
+        evict();
+}
+
+/// @brief Remove every cached response
+void ResponseCache::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_directory == "")
+        return;
+
+    std::error_code ec;
+    for (auto &entry : fs::directory_iterator(m_directory)) {
+        if (entry.path().extension() == ".cache")
+            fs::remove(entry.path(), ec);
+    }
+    m_totalBytes = 0;
+}
+
+/// @brief Test if a response is worth caching, i.e. not empty and not one of
+/// Alpha Vantage's error, information or call frequency notices
+/// @param data: The response body
+bool ResponseCache::isCacheable(const std::string &data)
+{
+    return classifyResponse(data).ok();
+}
+
+/// @brief Get a snapshot of the cache counters
+CacheStats ResponseCache::stats()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+/// @brief Get the file path of a key's entry (FNV-1a hash of the key)
+/// @param key: The canonical query
+std::string ResponseCache::entryPath(const std::string &key)
+{
+    std::uint64_t hash = 14695981039346656037ull;
+    for (unsigned char c : key) {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+
+    char name[24];
+    std::snprintf(name, sizeof(name), "%016llx",
+                  static_cast<unsigned long long>(hash));
+    return (fs::path(m_directory) / (std::string(name) + ".cache")).string();
+}
+
+/// @brief Delete the oldest entries until the cache is back under 90% of
+/// its size limit. Expects m_mutex to be held.
+void ResponseCache::evict()
+{
+    struct Entry {
+        fs::file_time_type written;
+        fs::path path;
+        std::uintmax_t size;
+    };
+
+    std::vector<Entry> entries;
+    std::uintmax_t total = 0;
+    std::error_code ec;
+
+    for (auto &entry : fs::directory_iterator(m_directory, ec)) {
+        if (!entry.is_regular_file(ec) || entry.path().extension() != ".cache")
+            continue;
+        Entry e{entry.last_write_time(ec), entry.path(), entry.file_size(ec)};
+        if (!ec) {
+            total += e.size;
+            entries.push_back(e);
+        }
+    }
+
+    std::sort(entries.begin(), entries.end(),
+              [](const Entry &a, const Entry &b) {
+                  return a.written < b.written;
+              });
+
+    std::uintmax_t target = m_maxBytes / 10 * 9;
+    for (auto &entry : entries) {
+        if (total <= target)
+            break;
+        if (fs::remove(entry.path, ec)) {
+            total -= entry.size;
+            ++m_stats.evictions;
+        }
+    }
+    m_totalBytes = total;
+}
+
+} // namespace avapi
@@ -0,0 +1,72 @@
+#include <algorithm>
+#include "avapi/ResponseStatus.hpp"
+
+namespace avapi {
+
+/// @brief Read the JSON string starting at the opening quote begin
+/// @param data: The response body
+/// @param begin: Offset of the opening quote
+/// @returns The raw string contents, escapes are kept as sent
+static std::string_view quoted(std::string_view data, size_t begin)
+{
+    size_t end = begin + 1;
+    while (end < data.size() && data[end] != '"')
+        end += data[end] == '\\' ? 2 : 1;
+    end = std::min(end, data.size());
+    return data.substr(begin + 1, end - begin - 1);
+}
+
+/// @brief Tell csv and JSON payloads apart from Alpha Vantage's error, notice
+/// and rate limit bodies. Those are JSON objects with a single key, so only
+/// the first key and its message are looked at, never the whole body.
+/// @param data: The response body
+/// @returns The avapi::ResponseStatus, message holding the notice text
+ResponseStatus classifyResponse(std::string_view data)
+{
+    ResponseStatus status;
+    const char *blank = " \t\r\n";
+
+    size_t start = data.find_first_not_of(blank);
+    if (start == std::string_view::npos) {
+        status.error = ApiError::EMPTY;
+        return status;
+    }
+    if (data[start] != '{' && data[start] != '[')
+        return status;
+    status.json = true;
+    if (data[start] == '[')
+        return status;
+
+    size_t key = data.find_first_not_of(blank, start + 1);
+    if (key == std::string_view::npos || data[key] != '"') {
+        if (key != std::string_view::npos && data[key] == '}')
+            status.error = ApiError::EMPTY_OBJECT;
+        return status;
+    }
+
+    std::string_view name = quoted(data, key);
+    if (name == "Error Message")
+        status.error = ApiError::INVALID_CALL;
+    else if (name == "Note")
+        status.error = ApiError::RATE_LIMITED;
+    else if (name == "Information")
+        status.error = ApiError::INFORMATION;
+    else
+        return status;
+
+    size_t value = data.find_first_not_of(blank, key + name.size() + 2);
+    if (value != std::string_view::npos && data[value] == ':')
+        value = data.find_first_not_of(blank, value + 1);
+    if (value != std::string_view::npos && data[value] == '"')
+        status.message = std::string(quoted(data, value));
+
+    // "Information" also carries the per minute and per day limits
+    if (status.error == ApiError::INFORMATION &&
+        (status.message.find("call frequency") != std::string::npos ||
+         status.message.find("rate limit") != std::string::npos)) {
+        status.error = ApiError::RATE_LIMITED;
+    }
+    return status;
+}
+
+} // namespace avapi
@@ -0,0 +1,73 @@
+#include <algorithm>
+#include "avapi/CurlSession.hpp"
+#include "avapi/ResponseCache.hpp"
+#include "avapi/ThreadPool.hpp"
+
+namespace avapi {
+
+/// @brief ThreadPool constructor
+/// @param threads: Number of worker threads (at least one is started)
+ThreadPool::ThreadPool(const size_t &threads)
+{
+    size_t n = std::max<size_t>(threads, 1);
+    for (size_t i = 0; i < n; ++i) {
+        m_workers.emplace_back([this]() { run(); });
+    }
+}
+
+/// @brief ThreadPool deconstructor, finishes the queued tasks and joins
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_cv.notify_all();
+    for (auto &worker : m_workers) {
+        worker.join();
+    }
+}
+
+/// @brief Return the shared background I/O loop. Its threads mostly wait on
+/// the network and the avapi::RequestScheduler, so it is sized above the
+/// core count.
+ThreadPool &ThreadPool::io()
+{
+    // The singletons its tasks use are created first, so that they are
+    // destroyed only after the pool has joined its threads
+    static bool singletons = (RequestScheduler::instance(),
+                              CurlSession::instance(),
+                              ResponseCache::instance(), true);
+    (void)singletons;
+    static ThreadPool pool(
+        std::max(4u, 2 * std::thread::hardware_concurrency()));
+    return pool;
+}
+
+/// @brief Return the shared pool for CPU bound work, one thread per core.
+/// Its tasks must not wait on other cpu() tasks.
+ThreadPool &ThreadPool::cpu()
+{
+    static ThreadPool pool(std::thread::hardware_concurrency());
+    return pool;
+}
+
+/// @brief Worker loop
+void ThreadPool::run()
+{
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv.wait(lock, [this]() { return m_stop || !m_tasks.empty(); });
+            if (m_tasks.empty())
+                return;
+            // top() is const, the task is moved out just before pop()
+            task = std::move(const_cast<Task &>(m_tasks.top()).run);
+            m_tasks.pop();
+        }
+        task();
+    }
+}
+
+} // namespace avapi
@@ -0,0 +1,174 @@
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include "avapi/TimestampParser.hpp"
+
+namespace avapi {
+
+/// @brief Read a run of ascii digits
+/// @param data: The first digit
+/// @param count: Number of digits
+/// @returns The value, or -1 if a character is not a digit
+static int readDigits(const char *data, const size_t &count)
+{
+    int value = 0;
+    for (size_t i = 0; i < count; ++i) {
+        unsigned digit = static_cast<unsigned>(data[i] - '0');
+        if (digit > 9)
+            return -1;
+        value = value * 10 + static_cast<int>(digit);
+    }
+    return value;
+}
+
+/// @brief Get the number of days in a month
+/// @param year: The year, for February of a leap year
+/// @param month: The month, 1 to 12
+static int daysInMonth(const int &year, const int &month)
+{
+    static const int DAYS[] = {31, 28, 31, 30, 31, 30,
+                               31, 31, 30, 31, 30, 31};
+    bool leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    return month == 2 && leap ? 29 : DAYS[month - 1];
+}
+
+/// @brief Get the day of the week of a day number, 0 = Sunday
+/// @param days: Days since 1970-01-01 (a Thursday)
+static std::int64_t weekday(const std::int64_t &days)
+{
+    return ((days % 7) + 11) % 7;
+}
+
+/// @brief Get the day number of the n-th Sunday of a month
+static std::int64_t nthSunday(const int &year, const unsigned &month,
+                              const int &n)
+{
+    std::int64_t first = TimestampParser::daysFromCivil(year, month, 1);
+    return first + (7 - weekday(first)) % 7 + 7 * (n - 1);
+}
+
+/// @brief Get the day number of the last Sunday of a month
+static std::int64_t lastSunday(const int &year, const unsigned &month)
+{
+    std::int64_t last =
+        month == 12 ? TimestampParser::daysFromCivil(year + 1, 1, 1) - 1
+                    : TimestampParser::daysFromCivil(year, month + 1, 1) - 1;
+    return last - weekday(last);
+}
+
+/// @brief Build the exception thrown for a malformed timestamp
+static std::invalid_argument invalidTimestamp(std::string_view input)
+{
+    return std::invalid_argument(
+        "avapi/TimestampParser.cpp: 'TimestampParser::parse': \"" +
+        std::string(input) + "\" is not a YYYY-MM-DD[ HH:MM:SS] timestamp.");
+}
+
+/// @brief TimestampParser constructor
+/// @param zone: The avapi::TimeZone timestamps are read in
+TimestampParser::TimestampParser(const TimeZone &zone) : m_zone(zone) {}
+
+/// @brief Convert "YYYY-MM-DD[ HH:MM[:SS]]" to a Unix timestamp (seconds
+/// since the unix epoch). A date without a time is read as midnight.
+/// @param input: The timestamp, anything after the seconds is ignored
+std::time_t TimestampParser::parse(std::string_view input)
+{
+    if (input.size() < 10 || input[4] != '-' || input[7] != '-')
+        throw invalidTimestamp(input);
+
+    // Intraday rows repeat their date, only a new one needs converting
+    if (!m_cached || std::memcmp(m_date, input.data(), 10) != 0) {
+        int year = readDigits(input.data(), 4);
+        int month = readDigits(input.data() + 5, 2);
+        int day = readDigits(input.data() + 8, 2);
+        if (year < 0 || month < 1 || month > 12 || day < 1 ||
+            day > daysInMonth(year, month)) {
+            throw invalidTimestamp(input);
+        }
+
+        m_year = year;
+        m_days = daysFromCivil(year, static_cast<unsigned>(month),
+                               static_cast<unsigned>(day));
+        std::memcpy(m_date, input.data(), 10);
+        m_cached = true;
+    }
+
+    std::int64_t seconds = 0;
+    if (input.size() > 10) {
+        if ((input[10] != ' ' && input[10] != 'T') || input.size() < 16 ||
+            input[13] != ':') {
+            throw invalidTimestamp(input);
+        }
+
+        int hour = readDigits(input.data() + 11, 2);
+        int minute = readDigits(input.data() + 14, 2);
+        int second = 0;
+        if (input.size() >= 19 && input[16] == ':')
+            second = readDigits(input.data() + 17, 2);
+        // A leap second (60) is accepted
+        if (hour < 0 || hour > 23 || minute < 0 || minute > 59 ||
+            second < 0 || second > 60) {
+            throw invalidTimestamp(input);
+        }
+
+        seconds = hour * 3600 + minute * 60 + second;
+    }
+
+    std::int64_t local = m_days * 86400 + seconds;
+    if (m_zone == TimeZone::UTC)
+        return static_cast<std::time_t>(local);
+    return static_cast<std::time_t>(toUtc(local, m_year));
+}
+
+/// @brief Get the number of days from 1970-01-01 to a civil date (proleptic
+/// Gregorian calendar)
+/// @param year: The year
+/// @param month: The month [1, 12]
+/// @param day: The day of the month [1, 31]
+std::int64_t TimestampParser::daysFromCivil(int year, unsigned month,
+                                            unsigned day)
+{
+    // Years start in March so the leap day is the last day of a year
+    year -= month <= 2;
+    const int era = (year >= 0 ? year : year - 399) / 400;
+    const unsigned yoe = static_cast<unsigned>(year - era * 400);
+    const unsigned doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 +
+                         day - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return static_cast<std::int64_t>(era) * 146097 +
+           static_cast<std::int64_t>(doe) - 719468;
+}
+
+/// @brief Convert US/Eastern local seconds to UTC. Times within the repeated
+/// hour at the end of daylight saving time are read as standard time.
+/// @param local: Local seconds since 1970-01-01 00:00
+/// @param year: The local year
+std::int64_t TimestampParser::toUtc(const std::int64_t &local, const int &year)
+{
+    if (year != m_dstYear) {
+        std::int64_t start;
+        std::int64_t end;
+        if (year >= 2007) {
+            start = nthSunday(year, 3, 2);
+            end = nthSunday(year, 11, 1);
+        }
+        else if (year >= 1987) {
+            start = nthSunday(year, 4, 1);
+            end = lastSunday(year, 10);
+        }
+        else {
+            start = lastSunday(year, 4);
+            end = lastSunday(year, 10);
+        }
+
+        // 2:00 standard time to 2:00 daylight time (1:00 standard time)
+        m_dstStart = start * 86400 + 2 * 3600;
+        m_dstEnd = end * 86400 + 1 * 3600;
+        m_dstYear = year;
+    }
+
+    bool dst = local >= m_dstStart && local < m_dstEnd;
+    return local + (dst ? 4 : 5) * 3600;
+}
+
+} // namespace avapi
@@ -0,0 +1,231 @@
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <typeinfo>
+#include "avapi/Transport.hpp"
+
+namespace avapi {
+
+/// @brief Guards the process wide default transport
+static std::mutex default_mutex;
+static std::shared_ptr<Transport> default_transport;
+
+/// @brief   Get a url, handing the body over as a single chunk
+/// @param   url The API query URL
+/// @param   on_chunk Called with the response body
+void Transport::get(const std::string &url, const ChunkCallback &on_chunk)
+{
+    std::string data = get(url);
+    on_chunk(data.data(), data.size());
+}
+
+/// @brief   Get several urls one after another
+/// @param   urls The API query URLs
+/// @param   max_concurrent Unused, requests are made sequentially
+/// @param   on_complete Called once per url with its index, body and an error
+/// message (empty on success)
+/// @param   admit Optional gate asked before each request starts
+void Transport::getMany(const std::vector<std::string> &urls,
+                        const size_t & /* max_concurrent */,
+                        const MultiCallback &on_complete,
+                        const AdmitCallback &admit)
+{
+    for (size_t i = 0; i < urls.size(); ++i) {
+        while (admit && !admit(i)) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+
+        std::string data;
+        std::string error;
+        try {
+            data = get(urls[i]);
+        }
+        catch (const std::exception &ex) {
+            error = ex.what();
+        }
+        on_complete(i, data, error);
+    }
+}
+
+/// @brief   Identify where bodies come from, so that the avapi::ResponseCache
+/// keeps the bodies of different transports apart
+/// @returns The dynamic type's name, overridden by the built-in transports
+std::string Transport::name() { return typeid(*this).name(); }
+
+/// @brief   Get the transport new ApiCalls start out with, a CurlTransport
+/// unless replaced with setDefaultTransport()
+std::shared_ptr<Transport> Transport::defaultTransport()
+{
+    std::lock_guard<std::mutex> lock(default_mutex);
+    if (default_transport == nullptr)
+        default_transport = std::make_shared<CurlTransport>();
+    return default_transport;
+}
+
+/// @brief   Replace the transport new ApiCalls start out with
+/// @param   transport The new default (nullptr restores a CurlTransport)
+void Transport::setDefaultTransport(const std::shared_ptr<Transport> &transport)
+{
+    std::lock_guard<std::mutex> lock(default_mutex);
+    default_transport = transport;
+}
+
+/// @brief   GET a url through the shared CurlSession
+/// @param   url The API query URL
+/// @returns The response body
+std::string CurlTransport::get(const std::string &url)
+{
+    return CurlSession::instance().perform(url);
+}
+
+/// @brief   GET a url through the shared CurlSession, chunk by chunk
+/// @param   url The API query URL
+/// @param   on_chunk Called for every received chunk
+void CurlTransport::get(const std::string &url, const ChunkCallback &on_chunk)
+{
+    CurlSession::instance().perform(url, on_chunk);
+}
+
+/// @brief   GET several urls concurrently through the shared CurlSession
+/// @param   urls The API query URLs
+/// @param   max_concurrent Maximum number of transfers in flight at once
+/// @param   on_complete Called once per url, in completion order
+/// @param   admit Optional gate asked before each transfer starts
+void CurlTransport::getMany(const std::vector<std::string> &urls,
+                            const size_t &max_concurrent,
+                            const MultiCallback &on_complete,
+                            const AdmitCallback &admit)
+{
+    CurlSession::instance().performMulti(urls, max_concurrent, on_complete,
+                                         admit);
+}
+
+/// @brief   Identify live Alpha Vantage bodies
+std::string CurlTransport::name() { return "curl"; }
+
+/// @brief   FileTransport constructor
+/// @param   directory The directory holding the captured responses
+FileTransport::FileTransport(const std::string &directory)
+    : directory(directory)
+{
+}
+
+/// @brief   Serve a query from a specific file
+/// @param   url The API query URL (the API key is ignored)
+/// @param   file The file name, relative to directory
+void FileTransport::map(const std::string &url, const std::string &file)
+{
+    m_files[key(url)] = file;
+}
+
+/// @brief   Get the file a query is served from
+/// @param   url The API query URL
+std::string FileTransport::filePath(const std::string &url)
+{
+    auto it = m_files.find(key(url));
+    if (it != m_files.end())
+        return (std::filesystem::path(directory) / it->second).string();
+
+    // Build the default name from the query's parameters
+    std::map<std::string, std::string> params;
+    std::string query = key(url);
+    size_t start = 0;
+    while (start < query.size()) {
+        size_t end = query.find('&', start);
+        if (end == std::string::npos)
+            end = query.size();
+        size_t eq = query.find('=', start);
+        if (eq != std::string::npos && eq < end) {
+            params[query.substr(start, eq - start)] =
+                query.substr(eq + 1, end - eq - 1);
+        }
+        start = end + 1;
+    }
+
+    std::string name = params["function"];
+    name += "_" + (params["symbol"] != "" ? params["symbol"]
+                                          : params["from_currency"]);
+    for (auto field : {"interval", "market", "to_currency"}) {
+        if (params[field] != "")
+            name += "_" + params[field];
+    }
+    name += params["datatype"] == "csv" ? ".csv" : ".json";
+
+    return (std::filesystem::path(directory) / name).string();
+}
+
+/// @brief   Identify the bodies captured in directory
+std::string FileTransport::name() { return "file:" + directory; }
+
+/// @brief   Reduce a query url to its sorted parameters without the API key,
+/// e.g. "function=TIME_SERIES_DAILY&outputsize=compact&symbol=GME"
+/// @param   url The API query URL
+std::string FileTransport::key(const std::string &url)
+{
+    size_t start = url.find('?');
+    start = start == std::string::npos ? 0 : start + 1;
+
+    std::vector<std::string> params;
+    while (start < url.size()) {
+        size_t end = url.find('&', start);
+        if (end == std::string::npos)
+            end = url.size();
+        std::string param = url.substr(start, end - start);
+        if (param != "" && param.compare(0, 7, "apikey=") != 0)
+            params.push_back(param);
+        start = end + 1;
+    }
+    std::sort(params.begin(), params.end());
+
+    std::string key;
+    for (auto &param : params) {
+        key += (key == "" ? "" : "&") + param;
+    }
+    return key;
+}
+
+/// @brief   Read a captured response
+/// @param   url The API query URL
+/// @returns The file's contents
+std::string FileTransport::get(const std::string &url)
+{
+    std::string path = filePath(url);
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("avapi/Transport.cpp: 'FileTransport::get': "
+                                 "\"" + path + "\" cannot be opened");
+    }
+
+    file.seekg(0, std::ios::end);
+    std::string data(static_cast<size_t>(file.tellg()), '\0');
+    file.seekg(0);
+    file.read(&data[0], data.size());
+    return data;
+}
+
+/// @brief   Read a captured response in 64 KiB chunks
+/// @param   url The API query URL
+/// @param   on_chunk Called for every chunk read
+void FileTransport::get(const std::string &url, const ChunkCallback &on_chunk)
+{
+    std::string path = filePath(url);
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("avapi/Transport.cpp: 'FileTransport::get': "
+                                 "\"" + path + "\" cannot be opened");
+    }
+
+    std::vector<char> buffer(64 * 1024);
+    while (file) {
+        file.read(buffer.data(), buffer.size());
+        if (file.gcount() > 0)
+            on_chunk(buffer.data(), static_cast<size_t>(file.gcount()));
+    }
+}
+
+} // namespace avapi
@@ -1,7 +1,8 @@
 #include <iostream>
 #include <iomanip>
-#include <nlohmann/json.hpp>
 #include <fmt/core.h>
+#include "avapi/JsonSax.hpp"
+#include "avapi/ThreadPool.hpp"
 #include "avapi/Company/Earnings.hpp"
 
 namespace avapi {
@@ -34,23 +35,22 @@ void CompanyEarnings::update()
     setFieldValue(Url::Field::SYMBOL, symbol);
 
     std::string data = curlQuery();
-
-    // Parse annual earnings data
-    nlohmann::json annual = nlohmann::json::parse(data)["annualEarnings"];
-    annual_earnings.data.clear();
-    for (auto &field : annual) {
-        annual_earnings.data.push_back(
-            {field["fiscalDateEnding"], field["reportedEPS"]});
+    if (!lastStatus().ok()) {
+        std::cerr << "avapi/Company/Earnings.cpp: Warning: "
+                     "'CompanyEarnings::Update': "
+                  << lastStatus().message << " No values were updated.\n";
+        return;
     }
 
-    // Parse quarterly earnings data
-    nlohmann::json quarterly = nlohmann::json::parse(data)["quarterlyEarnings"];
-    quarterly_earnings.data.clear();
-    for (auto &field : quarterly) {
-        quarterly_earnings.data.push_back(
-            {field["fiscalDateEnding"], field["reportedDate"],
-             field["reportedEPS"], field["estimatedEPS"], field["surprise"],
-             field["surprisePercentage"]});
-    }
+    // Annual and quarterly earnings in one pass
+    parseEarnings(data, annual_earnings, quarterly_earnings);
+}
+
+/// @brief Run update() on avapi::ThreadPool::io() without blocking. This
+/// CompanyEarnings must outlive the returned future and should not be read
+/// until it is ready.
+std::future<void> CompanyEarnings::updateAsync()
+{
+    return ThreadPool::io().submit([this]() { update(); }, priority);
 }
 } // namespace avapi
\ No newline at end of file
@@ -1,5 +1,6 @@
-#include <nlohmann/json.hpp>
 #include <iostream>
+#include "avapi/JsonSax.hpp"
+#include "avapi/ThreadPool.hpp"
 #include "avapi/Company/Overview.hpp"
 
 namespace avapi {
@@ -39,15 +40,21 @@ void CompanyOverview::update()
     setFieldValue(Url::Field::FUNCTION, "OVERVIEW");
     setFieldValue(Url::Field::SYMBOL, symbol);
 
-    nlohmann::json json_data = nlohmann::json::parse(curlQuery());
-    data.clear();
-    if (json_data.is_object()) {
-        auto obj = json_data.get<nlohmann::json::object_t>();
-        for (auto &kvp : obj) {
-            std::string key = kvp.first;
-            std::string val = kvp.second.get<std::string>();
-            this->data.insert({key, val});
-        }
+    std::string response = curlQuery();
+    if (!lastStatus().ok()) {
+        std::cerr << "avapi/Company/Overview.cpp: Warning: "
+                     "'CompanyOverview::Update': "
+                  << lastStatus().message << " No values were updated.\n";
+        return;
     }
+    parseOverview(response, data);
+}
+
+/// @brief Run update() on avapi::ThreadPool::io() without blocking. This
+/// CompanyOverview must outlive the returned future and should not be read
+/// until it is ready.
+std::future<void> CompanyOverview::updateAsync()
+{
+    return ThreadPool::io().submit([this]() { update(); }, priority);
 }
 } // namespace avapi
\ No newline at end of file
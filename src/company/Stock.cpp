@@ -1,9 +1,11 @@
 #include <sstream>
+#include <utility>
 #include <nlohmann/json.hpp>
 #include <fmt/core.h>
 #include "avapi/ApiCall.hpp"
 #include "avapi/misc.hpp"
 #include "avapi/Container/TimeSeries.hpp"
+#include "avapi/ThreadPool.hpp"
 #include "avapi/Company/Stock.hpp"
 #include <rapidcsv.h>
 
@@ -29,51 +31,134 @@ CompanyStock::CompanyStock(const std::string &symbol, const std::string &key)
 /// @param   adjusted: Adjusted or Non-Adjusted data
 /// @param   interval: The interval for INTRADAY, ignored otherwise (default =
 /// "30min")
+/// @param   columns: The columns to keep (default = all)
 TimeSeries CompanyStock::getTimeSeries(const avapi::SeriesType &type,
                                        const bool &adjusted,
-                                       const std::string &interval)
+                                       const std::string &interval,
+                                       const CsvProjection &columns)
+{
+    timeSeriesQuery(type, adjusted, interval);
+
+    // Download, parse, and create TimeSeries from csv data
+    TimeSeries series = curlQueryCsv(columns);
+    labelTimeSeries(series, type, adjusted, interval);
+    return series;
+}
+
+/// @brief   Set up the query for a TimeSeries without downloading it
+/// @param   type: The avapi::SeriesType
+/// @param   adjusted: Adjusted or Non-Adjusted data
+/// @param   interval: The interval for INTRADAY, ignored otherwise (default =
+/// "30min")
+/// @returns The Alpha Vantage API query URL
+std::string CompanyStock::timeSeriesQuery(const avapi::SeriesType &type,
+                                          const bool &adjusted,
+                                          const std::string &interval)
 {
     resetQuery();
 
-    std::string title;
     std::string function = series_function[static_cast<int>(type)];
 
     // Check if intraday (Uses different parameters than daily, weekly, monthly)
     if (type == SeriesType::INTRADAY) {
         setFieldValue(Url::Field::FUNCTION, function);
         setFieldValue(Url::Field::INTERVAL, interval);
-        if (adjusted) {
-            setFieldValue(Url::Field::ADJUSTED, "true");
-            title = function + " (" + interval + ", Adjusted)";
-        }
-        else {
-            setFieldValue(Url::Field::ADJUSTED, "false");
-            title = function + " (" + interval + ", Non-Adjusted)";
-        }
+        setFieldValue(Url::Field::ADJUSTED, adjusted ? "true" : "false");
+    }
+    else if (adjusted) {
+        setFieldValue(Url::Field::FUNCTION, function + "_ADJUSTED");
     }
     else {
-        if (adjusted) {
-            setFieldValue(Url::Field::FUNCTION, function + "_ADJUSTED");
-            title = function + " (Adjusted)";
-        }
-        else {
-            setFieldValue(Url::Field::FUNCTION, function);
-            title = function + " (Non-Adjusted)";
-        }
+        setFieldValue(Url::Field::FUNCTION, function);
     }
 
     // Set other needed API fields
     setFieldValue(Url::Field::SYMBOL, symbol);
     setFieldValue(Url::Field::OUTPUT_SIZE, output_size);
     setFieldValue(Url::Field::DATA_TYPE, "csv");
+    return buildQuery();
+}
+
+/// @brief   Create a TimeSeries from a downloaded csv response
+/// @param   csv: The csv response for this symbol
+/// @param   type: The avapi::SeriesType that was requested
+/// @param   adjusted: Adjusted or Non-Adjusted data
+/// @param   interval: The interval for INTRADAY, ignored otherwise (default =
+/// "30min")
+/// @param   columns: The columns to keep (default = all)
+TimeSeries CompanyStock::timeSeriesFromCsv(const std::string &csv,
+                                           const avapi::SeriesType &type,
+                                           const bool &adjusted,
+                                           const std::string &interval,
+                                           const CsvProjection &columns)
+{
+    TimeSeries series = parseCsvString(csv, columns);
+    labelTimeSeries(series, type, adjusted, interval);
+    return series;
+}
+
+/// @brief   Set a freshly parsed TimeSeries' symbol, type and title
+/// @param   series: The TimeSeries to label
+/// @param   type: The avapi::SeriesType that was requested
+/// @param   adjusted: Adjusted or Non-Adjusted data
+/// @param   interval: The interval for INTRADAY, ignored otherwise
+void CompanyStock::labelTimeSeries(TimeSeries &series,
+                                   const avapi::SeriesType &type,
+                                   const bool &adjusted,
+                                   const std::string &interval)
+{
+    std::string function = series_function[static_cast<int>(type)];
+    std::string title;
+
+    if (type == SeriesType::INTRADAY) {
+        title = function + " (" + interval +
+                (adjusted ? ", Adjusted)" : ", Non-Adjusted)");
+    }
+    else {
+        title = function + (adjusted ? " (Adjusted)" : " (Non-Adjusted)");
+    }
 
-    // Download, parse, and create TimeSeries from csv data
-    TimeSeries series = parseCsvString(curlQuery());
     series.symbol = symbol;
     series.type = type;
     series.is_adjusted = adjusted;
+    series.interval = type == SeriesType::INTRADAY ? interval : "";
     series.title = symbol + ": " + title;
-    return series;
+}
+
+/// @brief   Bring a previously fetched TimeSeries up to date. Only the
+/// compact series (the latest 100 bars) is downloaded and merged in, the full
+/// series is downloaded only when series is empty or more than 100 bars old.
+/// Downloads are parsed into the columns series already has.
+/// @param   series: The TimeSeries to update, its type, is_adjusted and
+/// interval select the series to download
+/// @param   interval: The interval for INTRADAY when series has none, e.g.
+/// was never fetched (default = "30min")
+void CompanyStock::refreshTimeSeries(TimeSeries &series,
+                                     const std::string &interval)
+{
+    SeriesType type = series.type;
+    bool adjusted = series.is_adjusted;
+    std::string bars = series.interval.empty() ? interval : series.interval;
+    CsvProjection columns = CsvProjection::matching(series.headers);
+
+    if (series.rowCount() > 0) {
+        timeSeriesQuery(type, adjusted, bars);
+        setFieldValue(Url::Field::OUTPUT_SIZE, "compact");
+
+        TimeSeries update = curlQueryCsv(columns);
+        if (series.merge(update)) {
+            labelTimeSeries(series, type, adjusted, bars);
+            return;
+        }
+    }
+
+    // The gap is wider than the compact window, start over
+    timeSeriesQuery(type, adjusted, bars);
+    setFieldValue(Url::Field::OUTPUT_SIZE, "full");
+
+    TimeSeries full = curlQueryCsv(columns);
+    labelTimeSeries(full, type, adjusted, bars);
+    series = std::move(full);
 }
 
 GlobalQuote CompanyStock::getGlobalQuote()
@@ -85,7 +170,13 @@ GlobalQuote CompanyStock::getGlobalQuote()
     setFieldValue(Url::Field::DATA_TYPE, "csv");
 
     // Download csv data for global quote
-    std::stringstream csv(curlQuery());
+    std::stringstream csv(curlQuery(Priority::LIVE));
+    if (!lastStatus().ok() || lastStatus().json) {
+        throw ResponseError(lastStatus(),
+                            "avapi/CompanyStock.cpp: 'CompanyStock::"
+                            "GlobalQuote': Json Response:" +
+                                csv.str());
+    }
 
     // Get global quote row from csv std::string
     rapidcsv::Document doc(csv);
@@ -117,6 +208,57 @@ GlobalQuote CompanyStock::getGlobalQuote()
     return {symbol, timestamp, data_f};
 }
 
+/// @brief   Get an avapi::TimeSeries without blocking. The request runs on
+/// its own CompanyStock copy, so this object may be reused right away.
+/// @param   type: The avapi::SeriesType
+/// @param   adjusted: Adjusted or Non-Adjusted data
+/// @param   interval: The interval for INTRADAY, ignored otherwise (default =
+/// "30min")
+/// @param   columns: The columns to keep (default = all)
+std::future<TimeSeries>
+CompanyStock::getTimeSeriesAsync(const avapi::SeriesType &type,
+                                 const bool &adjusted,
+                                 const std::string &interval,
+                                 const CsvProjection &columns)
+{
+    std::string symbol = this->symbol;
+    std::string key = api_key;
+    std::string size = output_size;
+    Priority priority = this->priority;
+    bool streaming = this->streaming;
+    std::shared_ptr<Transport> transport = this->transport;
+
+    return ThreadPool::io().submit(
+        [=]() {
+            CompanyStock stock(symbol, key);
+            stock.output_size = size;
+            stock.priority = priority;
+            stock.streaming = streaming;
+            stock.transport = transport;
+            return stock.getTimeSeries(type, adjusted, interval, columns);
+        },
+        priority);
+}
+
+/// @brief   Get an avapi::GlobalQuote without blocking, queued ahead of
+/// NORMAL and BACKFILL work as the quote itself is a LIVE request
+std::future<GlobalQuote> CompanyStock::getGlobalQuoteAsync()
+{
+    std::string symbol = this->symbol;
+    std::string key = api_key;
+    Priority priority = this->priority;
+    std::shared_ptr<Transport> transport = this->transport;
+
+    return ThreadPool::io().submit(
+        [=]() {
+            CompanyStock stock(symbol, key);
+            stock.priority = priority;
+            stock.transport = transport;
+            return stock.getGlobalQuote();
+        },
+        Priority::LIVE);
+}
+
 const std::vector<std::string> CompanyStock::series_function = {
     "TIME_SERIES_INTRADAY", "TIME_SERIES_DAILY", "TIME_SERIES_WEEKLY",
     "TIME_SERIES_MONTHLY"};
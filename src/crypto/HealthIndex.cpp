@@ -1,7 +1,7 @@
 #include <iostream>
-#include <nlohmann/json.hpp>
 #include <fmt/core.h>
-#include "avapi/misc.hpp"
+#include "avapi/JsonSax.hpp"
+#include "avapi/ThreadPool.hpp"
 #include "avapi/Crypto/HealthIndex.hpp"
 
 namespace avapi {
@@ -32,19 +32,14 @@ void HealthIndex::update()
     setFieldValue(Url::Field::FUNCTION, "CRYPTO_RATING");
     setFieldValue(Url::Field::SYMBOL, symbol);
 
-    nlohmann::json json =
-        nlohmann::json::parse(curlQuery())["Crypto Rating (FCAS)"];
-
-    // Skip push_back for "8. last refreshed"
-    data.push_back(json["1. symbol"]);
-    data.push_back(json["2. name"]);
-    data.push_back(json["3. fcas rating"]);
-    data.push_back(json["4. fcas score"]);
-    data.push_back(json["5. developer score"]);
-    data.push_back(json["6. market maturity score"]);
-    data.push_back(json["7. utility score"]);
-    timestamp = avapi::toUnixTimestamp(json["8. last refreshed"]);
-    data.push_back(json["9. timezone"]);
+    std::string response = curlQuery();
+    if (!lastStatus().ok()) {
+        std::cerr << "avapi/Crypto/HealthIndex.cpp: Warning: "
+                     "'HealthIndex::Update': "
+                  << lastStatus().message << " No values were updated.\n";
+        return;
+    }
+    parseHealthIndex(response, data, timestamp);
 }
 
 /// @brief Print formatted HealthIndex data
@@ -65,4 +60,12 @@ void HealthIndex::printData()
     fmt::print("|{:<26}{:>12}|\n", "Timezone:", data[7]);
 }
 
+/// @brief Run update() on avapi::ThreadPool::io() without blocking. This
+/// HealthIndex must outlive the returned future and should not be read
+/// until it is ready.
+std::future<void> HealthIndex::updateAsync()
+{
+    return ThreadPool::io().submit([this]() { update(); }, priority);
+}
+
 } // namespace avapi
@@ -1,10 +1,12 @@
 #include <iostream>
 #include <sstream>
-#include <nlohmann/json.hpp>
+#include <utility>
 #include <fmt/core.h>
 #include "avapi/ApiCall.hpp"
+#include "avapi/JsonSax.hpp"
 #include "avapi/misc.hpp"
 #include "avapi/Container/TimeSeries.hpp"
+#include "avapi/ThreadPool.hpp"
 #include "avapi/Crypto/Pricing.hpp"
 
 namespace avapi {
@@ -26,24 +28,37 @@ CryptoPricing::CryptoPricing(const std::string &symbol, const std::string &key)
 /// @brief Get a specified TimeSeries for this cryptocurrency
 /// @param type: The avapi::SeriesType (INTRADAY not available)
 /// @param market: The exchange market (default = "USD")
-/// @returns A TimeSeries ordered [open, high, low, close, volume]
+/// @param columns: The columns to keep (default = CsvProjection::crypto())
+/// @returns A TimeSeries ordered [open, high, low, close, volume] by default
 TimeSeries CryptoPricing::getTimeSeries(const SeriesType &type,
-                                        const std::string &market)
+                                        const std::string &market,
+                                        const CsvProjection &columns)
 {
-    resetQuery();
+    timeSeriesQuery(type, market);
+
+    // Download, parse, and create TimeSeries from csv data
+    TimeSeries series = curlQueryCsv(columns, TimeZone::UTC);
+    labelTimeSeries(series, type, market);
+    return series;
+}
 
-    std::string function;
-    SeriesType check = type;
+/// @brief Set up the query for a TimeSeries without downloading it
+/// @param type: The avapi::SeriesType (INTRADAY not available)
+/// @param market: The exchange market (default = "USD")
+/// @returns The Alpha Vantage API query URL
+std::string CryptoPricing::timeSeriesQuery(const SeriesType &type,
+                                           const std::string &market)
+{
+    resetQuery();
 
     // Intraday not available from Alpha Vantage
-    if (check == SeriesType::INTRADAY) {
-        check = SeriesType::DAILY;
+    if (type == SeriesType::INTRADAY) {
         std::cout << "avapi/Crypto.cpp: exception: "
                      "'avapi::Crypto::getTimeSeries': Intraday not available "
                      "from Alpha Vantage, returning a daily TimeSeries.\n";
     }
 
-    function = series_function[static_cast<int>(check)];
+    std::string function = series_function[static_cast<int>(checkType(type))];
     setFieldValue(Url::Field::FUNCTION, function);
 
     // Set other needed API fields
@@ -51,15 +66,73 @@ TimeSeries CryptoPricing::getTimeSeries(const SeriesType &type,
     setFieldValue(Url::Field::MARKET, market);
     setFieldValue(Url::Field::OUTPUT_SIZE, output_size);
     setFieldValue(Url::Field::DATA_TYPE, "csv");
+    return buildQuery();
+}
+
+/// @brief Create a TimeSeries from a downloaded csv response
+/// @param csv: The csv response for this cryptocurrency
+/// @param type: The avapi::SeriesType that was requested
+/// @param market: The exchange market (default = "USD")
+/// @param columns: The columns to keep (default = CsvProjection::crypto())
+TimeSeries CryptoPricing::timeSeriesFromCsv(const std::string &csv,
+                                            const SeriesType &type,
+                                            const std::string &market,
+                                            const CsvProjection &columns)
+{
+    TimeSeries series = parseCsvString(csv, columns, TimeZone::UTC);
+    labelTimeSeries(series, type, market);
+    return series;
+}
+
+/// @brief Set a freshly parsed TimeSeries' symbol, type, market and title
+/// @param series: The TimeSeries to label
+/// @param type: The avapi::SeriesType that was requested
+/// @param market: The exchange market
+void CryptoPricing::labelTimeSeries(TimeSeries &series, const SeriesType &type,
+                                    const std::string &market)
+{
+    SeriesType check = checkType(type);
+    std::string function = series_function[static_cast<int>(check)];
 
-    // Download, parse, and create TimeSeries from csv data
-    TimeSeries series = parseCsvString(curlQuery(), true);
     series.symbol = symbol;
     series.type = check;
     series.is_adjusted = false;
     series.market = market;
     series.title = symbol + ": " + function;
-    return series;
+}
+
+/// @brief Bring a previously fetched TimeSeries up to date. Only the compact
+/// series is requested and merged in, the full series is requested only when
+/// series is empty or the compact series no longer reaches back to it.
+/// Downloads are parsed into the columns series already has.
+/// @param series: The TimeSeries to update, its type and market select the
+/// series to download
+void CryptoPricing::refreshTimeSeries(TimeSeries &series)
+{
+    SeriesType type = series.type;
+    std::string market = series.market;
+    CsvProjection columns = series.headers.empty()
+                                ? CsvProjection::crypto()
+                                : CsvProjection::matching(series.headers);
+
+    if (series.rowCount() > 0) {
+        timeSeriesQuery(type, market);
+        setFieldValue(Url::Field::OUTPUT_SIZE, "compact");
+
+        TimeSeries update = curlQueryCsv(columns, TimeZone::UTC);
+        if (series.merge(update)) {
+            labelTimeSeries(series, type, market);
+            return;
+        }
+    }
+
+    // The gap is wider than the compact window, start over
+    timeSeriesQuery(type, market);
+    setFieldValue(Url::Field::OUTPUT_SIZE, "full");
+
+    TimeSeries full = curlQueryCsv(columns, TimeZone::UTC);
+    labelTimeSeries(full, type, market);
+    series = std::move(full);
 }
 
 /// @brief Get an ExchangeRate for this cryptocurrency
@@ -71,16 +144,71 @@ ExchangeRate CryptoPricing::exchange(const std::string &market)
     setFieldValue(Url::Field::FROM_CURRENCY, this->symbol);
     setFieldValue(Url::Field::TO_CURRENCY, market);
 
-    nlohmann::json json =
-        nlohmann::json::parse(curlQuery())["Realtime Currency Exchange Rate"];
+    std::string response = curlQuery(Priority::LIVE);
+    if (!lastStatus().ok()) {
+        throw ResponseError(lastStatus(),
+                            "avapi/Crypto/Pricing.cpp: 'CryptoPricing::"
+                            "exchange': " +
+                                lastStatus().message);
+    }
+    return parseExchangeRate(response, symbol, market);
+}
+
+/// @brief Get a TimeSeries without blocking. The request runs on its own
+/// CryptoPricing copy, so this object may be reused right away.
+/// @param type: The avapi::SeriesType (INTRADAY not available)
+/// @param market: The exchange market (default = "USD")
+/// @param columns: The columns to keep (default = CsvProjection::crypto())
+std::future<TimeSeries>
+CryptoPricing::getTimeSeriesAsync(const SeriesType &type,
+                                  const std::string &market,
+                                  const CsvProjection &columns)
+{
+    std::string symbol = this->symbol;
+    std::string key = api_key;
+    std::string size = output_size;
+    Priority priority = this->priority;
+    bool streaming = this->streaming;
+    std::shared_ptr<Transport> transport = this->transport;
+
+    return ThreadPool::io().submit(
+        [=]() {
+            CryptoPricing pricing(symbol, key);
+            pricing.output_size = size;
+            pricing.priority = priority;
+            pricing.streaming = streaming;
+            pricing.transport = transport;
+            return pricing.getTimeSeries(type, market, columns);
+        },
+        priority);
+}
 
-    std::time_t timestamp = avapi::toUnixTimestamp(json["6. Last Refreshed"]);
-    std::vector<double> data = {
-        std::stod(std::string(json["5. Exchange Rate"])),
-        std::stod(std::string(json["8. Bid Price"])),
-        std::stod(std::string(json["9. Ask Price"]))};
+/// @brief Get an ExchangeRate without blocking, queued ahead of NORMAL and
+/// BACKFILL work as the rate itself is a LIVE request
+/// @param market: Exchange Market e.g. ("USD")
+std::future<ExchangeRate>
+CryptoPricing::exchangeAsync(const std::string &market)
+{
+    std::string symbol = this->symbol;
+    std::string key = api_key;
+    Priority priority = this->priority;
+    std::shared_ptr<Transport> transport = this->transport;
 
-    return {symbol, market, timestamp, data};
+    return ThreadPool::io().submit(
+        [=]() {
+            CryptoPricing pricing(symbol, key);
+            pricing.priority = priority;
+            pricing.transport = transport;
+            return pricing.exchange(market);
+        },
+        Priority::LIVE);
+}
+
+/// @brief Map a requested SeriesType onto one Alpha Vantage provides
+/// @param type: The requested avapi::SeriesType
+SeriesType CryptoPricing::checkType(const SeriesType &type)
+{
+    return type == SeriesType::INTRADAY ? SeriesType::DAILY : type;
 }
 
 const std::vector<std::string> CryptoPricing::series_function = {
@@ -1,9 +1,11 @@
 #include <fstream>
-#include <sstream>
+#include <stdexcept>
 #include <nlohmann/json.hpp>
-#include "rapidcsv.h"
 #include "avapi/Container/TimeSeries.hpp"
+#include "avapi/CsvTokenizer.hpp"
+#include "avapi/MappedFile.hpp"
 #include "avapi/misc.hpp"
+#include "avapi/ResponseStatus.hpp"
 
 namespace avapi {
 
@@ -43,16 +45,13 @@ std::string readApiKey(const std::string &file_path)
     return api_key;
 }
 
-/// @brief   Converts date + time string "%Y-%m-%d %H:%M:%S" to Unix Timestamp
-/// (Seconds since unix epoch)
+/// @brief   Converts date + time string "%Y-%m-%d %H:%M:%S" (or a date alone)
+/// to Unix Timestamp (Seconds since unix epoch)
 /// @param   input: The string to be converted
-std::time_t toUnixTimestamp(const std::string &input)
+/// @param   zone: The avapi::TimeZone input is in (default = US_EASTERN)
+std::time_t toUnixTimestamp(std::string_view input, const TimeZone &zone)
 {
-    std::tm t{};
-    std::istringstream ss(input);
-    std::string format = "%Y-%m-%d %H:%M:%S";
-    ss >> std::get_time(&t, format.c_str());
-    return mktime(&t);
+    return TimestampParser(zone).parse(input);
 }
 
 /// @brief Test if a string is JSON convertable
@@ -68,107 +67,169 @@ bool isJsonString(const std::string &data)
     return true;
 }
 
+/// @brief Shorten Alpha Vantage's long csv column names
+/// @param header: The column name as sent by Alpha Vantage
+std::string normalizeHeader(const std::string &header)
+{
+    if (header == "adjusted close" || header == "adjusted_close")
+        return "adj_close";
+    else if (header == "dividend amount" || header == "dividend_amount")
+        return "dividends";
+    else if (header == "split coefficient" || header == "split_coefficient")
+        return "split_coeff";
+    return header;
+}
+
 /// @brief Returns a TimeSeries created from a csv std::string
 /// @param data: An csv std::string object
-/// @param crypto: Whether the csv data is from a cryptocurrency
-TimeSeries parseCsvString(const std::string &data, const bool &crypto)
+TimeSeries parseCsvString(const std::string &data)
 {
-    // Create rapidcsv::Document object from csv string
-    std::stringstream sstream(data);
-    rapidcsv::Document doc(sstream);
-    size_t n_rows = doc.GetRowCount();
+    return parseCsvString(data, CsvProjection());
+}
 
+/// @brief Returns a TimeSeries of selected columns from a csv std::string
+/// @param data: An csv std::string object
+/// @param projection: The columns to keep
+/// @param zone: The time zone of the timestamps (default = US_EASTERN)
+TimeSeries parseCsvString(const std::string &data,
+                          const CsvProjection &projection,
+                          const TimeZone &zone)
+{
     // Test if data is really a JSON response
-    if (n_rows <= 2 && isJsonString(data)) {
-        nlohmann::json parser = nlohmann::json::parse(data);
-        std::string error =
-            "'avapi::parseCsvString': Json Response:" + parser.dump(4);
-        throw std::exception(error.c_str());
+    ResponseStatus status = classifyResponse(data);
+    if (status.json) {
+        throw ResponseError(status, "'avapi::parseCsvString': Json Response:" +
+                                        data);
     }
 
-    // Successful parse (Cells could still be invalid...)
-    TimeSeries series;
-    if (crypto) {
-        // 10 -> Market Cap = volume (From alpha vantage)
-        // 5-8 -> Redundant USD columns
-        doc.RemoveColumn(10);
-        doc.RemoveColumn(8);
-        doc.RemoveColumn(7);
-        doc.RemoveColumn(6);
-        doc.RemoveColumn(5);
-    }
+    return CsvTokenizer(projection, zone).parse(data);
+}
 
-    for (size_t i = 0; i < n_rows; ++i) {
-        std::vector<std::string> row = doc.GetRow<std::string>(i);
+/// @brief Returns a TimeSeries created from a csv file. The file is memory
+/// mapped and tokenized straight from the mapped pages.
+/// @param file_path: The csv file's path
+TimeSeries parseCsvFile(const std::string &file_path)
+{
+    MappedFile file(file_path);
+    return CsvTokenizer().parse(file.view());
+}
 
-        // Transform vector into floats, skip timestamp column
-        std::vector<double> data;
-        std::transform(row.begin() + 1, row.end(), std::back_inserter(data),
-                       [](std::string &value) { return std::stod(value); });
+/// @brief Returns a TimeSeries of selected columns from a csv file
+/// @param file_path: The csv file's path
+/// @param projection: The columns to keep
+/// @param zone: The time zone of the timestamps (default = US_EASTERN)
+TimeSeries parseCsvFile(const std::string &file_path,
+                        const CsvProjection &projection, const TimeZone &zone)
+{
+    MappedFile file(file_path);
+    return CsvTokenizer(projection, zone).parse(file.view());
+}
 
-        TimePair pair(toUnixTimestamp(row[0]), data);
-        series.pushBack({toUnixTimestamp(row[0]), data});
+/// @brief Returns a TimeSeries created from a csv std::string, its columns
+/// drawn from the given memory resource
+/// @param data: An csv std::string object
+/// @param resource: The memory resource, which must outlive the TimeSeries
+/// @param crypto: Whether the csv data is from a cryptocurrency
+TimeSeries parseCsvString(const std::string &data,
+                          std::pmr::memory_resource *resource,
+                          const bool &crypto)
+{
+    ResponseStatus status = classifyResponse(data);
+    if (status.json) {
+        throw ResponseError(status, "'avapi::parseCsvString': Json Response:" +
+                                        data);
     }
 
-    std::vector<std::string> headers = doc.GetColumnNames();
-    for (auto &header : headers) {
-
-        if (header == "adjusted close" || header == "adjusted_close")
-            header = "adj_close";
-        else if (header == "dividend amount" || header == "dividend_amount")
-            header = "dividends";
-        else if (header == "split coefficient" || header == "split_coefficient")
-            header = "split_coeff";
-    }
-    series.headers = headers;
-    return series;
+    return CsvTokenizer(crypto).parse(data, resource);
 }
 
-/// @brief Returns a TimeSeries created from a csv file
+/// @brief Returns a TimeSeries created from a csv file, its columns drawn
+/// from the given memory resource
 /// @param file_path: The csv file's path
+/// @param resource: The memory resource, which must outlive the TimeSeries
 /// @param crypto: Whether the csv data is from a cryptocurrency
-TimeSeries parseCsvFile(const std::string &file_path, const bool &crypto)
-{
-    // Create rapidcsv::Document object from csv string
-    rapidcsv::Document doc(file_path);
-    size_t n_rows = doc.GetRowCount();
-
-    // Successful parse (Cells could still be invalid...)
-    TimeSeries series;
-    if (crypto) {
-        // 10 -> Market Cap = volume (From alpha vantage)
-        // 5-8 -> Redundant USD columns
-        doc.RemoveColumn(10);
-        doc.RemoveColumn(8);
-        doc.RemoveColumn(7);
-        doc.RemoveColumn(6);
-        doc.RemoveColumn(5);
+TimeSeries parseCsvFile(const std::string &file_path,
+                        std::pmr::memory_resource *resource,
+                        const bool &crypto)
+{
+    MappedFile file(file_path);
+    return CsvTokenizer(crypto).parse(file.view(), resource);
+}
+
+/// @brief Returns a Series of the given Schema from a csv std::string
+/// @param data: An csv std::string object
+template <typename Schema>
+Series<Schema> parseCsvString(const std::string &data)
+{
+    ResponseStatus status = classifyResponse(data);
+    if (status.json) {
+        throw ResponseError(status, "'avapi::parseCsvString': Json Response:" +
+                                        data);
     }
 
-    for (size_t i = 0; i < n_rows; ++i) {
-        std::vector<std::string> row = doc.GetRow<std::string>(i);
+    CsvTokenizer tokenizer(Series<Schema>::projection(), Schema::zone);
+    return tokenizer.parseSeries<Schema>(data);
+}
 
-        // Transform vector into floats, skip timestamp column
-        std::vector<double> data;
-        std::transform(row.begin() + 1, row.end(), std::back_inserter(data),
-                       [](std::string &value) { return std::stod(value); });
+/// @brief Returns a Series of the given Schema from a csv file
+/// @param file_path: The csv file's path
+template <typename Schema>
+Series<Schema> parseCsvFile(const std::string &file_path)
+{
+    MappedFile file(file_path);
+    CsvTokenizer tokenizer(Series<Schema>::projection(), Schema::zone);
+    return tokenizer.parseSeries<Schema>(file.view());
+}
 
-        TimePair pair(toUnixTimestamp(row[0]), data);
-        series.pushBack({toUnixTimestamp(row[0]), data});
+template Series<OHLCV> parseCsvString(const std::string &data);
+template Series<AdjustedDaily> parseCsvString(const std::string &data);
+template Series<AdjustedWeekly> parseCsvString(const std::string &data);
+template Series<CryptoOHLCV> parseCsvString(const std::string &data);
+template Series<OHLCV> parseCsvFile(const std::string &file_path);
+template Series<AdjustedDaily> parseCsvFile(const std::string &file_path);
+template Series<AdjustedWeekly> parseCsvFile(const std::string &file_path);
+template Series<CryptoOHLCV> parseCsvFile(const std::string &file_path);
+
+/// @brief Returns a FixedTimeSeries from a csv std::string, prices kept as
+/// exact integer ticks
+/// @param data: An csv std::string object
+/// @param crypto: Whether the csv data is from a cryptocurrency, read with
+/// 8 decimals instead of 4
+FixedTimeSeries parseCsvStringFixed(const std::string &data,
+                                   const bool &crypto)
+{
+    ResponseStatus status = classifyResponse(data);
+    if (status.json) {
+        throw ResponseError(status,
+                            "'avapi::parseCsvStringFixed': Json Response:" +
+                                data);
     }
 
-    std::vector<std::string> headers = doc.GetColumnNames();
-    for (auto &header : headers) {
+    return CsvTokenizer(crypto).parseFixed(data, crypto ? 8 : 4);
+}
 
-        if (header == "adjusted close" || header == "adjusted_close")
-            header = "adj_close";
-        else if (header == "dividend amount" || header == "dividend_amount")
-            header = "dividends";
-        else if (header == "split coefficient" || header == "split_coefficient")
-            header = "split_coeff";
-    }
-    series.headers = headers;
-    return series;
+/// @brief Returns a FixedTimeSeries from a csv file, prices kept as exact
+/// integer ticks
+/// @param file_path: The csv file's path
+/// @param crypto: Whether the csv data is from a cryptocurrency, read with
+/// 8 decimals instead of 4
+FixedTimeSeries parseCsvFileFixed(const std::string &file_path,
+                                  const bool &crypto)
+{
+    MappedFile file(file_path);
+    return CsvTokenizer(crypto).parseFixed(file.view(), crypto ? 8 : 4);
+}
+
+/// @brief Returns a TimeSeries created from a large csv file, parsed in
+/// chunks across avapi::ThreadPool::cpu()
+/// @param file_path: The csv file's path
+/// @param crypto: Whether the csv data is from a cryptocurrency
+/// @param threads: Number of chunks (default = 0, one per core)
+TimeSeries parseCsvFileParallel(const std::string &file_path,
+                                const bool &crypto, const size_t &threads)
+{
+    MappedFile file(file_path);
+    return CsvTokenizer(crypto).parseParallel(file.view(), threads);
 }
 
 } // namespace avapi
\ No newline at end of file
@@ -1,11 +1,28 @@
-#include "avapi/TimeSeries.hpp"
+#include "avapi/misc.hpp"
 #include "catch.hpp"
 
 TEST_CASE("avapi::toUnixTimestamp()")
 {
-    REQUIRE(avapi::toUnixTimestamp("2020-08-05") == 1596607200);
-    REQUIRE(avapi::toUnixTimestamp("2014-02-09") == 1391925600);
-    REQUIRE(avapi::toUnixTimestamp("2003-09-17") == 1063778400);
-    REQUIRE(avapi::toUnixTimestamp("2030-12-25") == 1924408800);
-    REQUIRE(avapi::toUnixTimestamp("1997-01-02") == 852184800);
-}
\ No newline at end of file
+    REQUIRE(avapi::toUnixTimestamp("2020-08-05") == 1596600000);
+    REQUIRE(avapi::toUnixTimestamp("2014-02-09") == 1391922000);
+    REQUIRE(avapi::toUnixTimestamp("2003-09-17") == 1063771200);
+    REQUIRE(avapi::toUnixTimestamp("2030-12-25") == 1924405200);
+    REQUIRE(avapi::toUnixTimestamp("1997-01-02") == 852181200);
+    REQUIRE(avapi::toUnixTimestamp("2021-02-19 15:30:00") == 1613766600);
+    REQUIRE(avapi::toUnixTimestamp("2021-03-05 19:49:01",
+                                   avapi::TimeZone::UTC) == 1614973741);
+    REQUIRE_THROWS(avapi::toUnixTimestamp("2021-02-19s"));
+    REQUIRE_THROWS(avapi::toUnixTimestamp("2021-02-19 99:99:99"));
+    REQUIRE_THROWS(avapi::toUnixTimestamp("2021-02-19 24:00:00"));
+    REQUIRE_THROWS(avapi::toUnixTimestamp("2021-02-19 15:60:00"));
+    REQUIRE_THROWS(avapi::toUnixTimestamp("2021-02-19 15:30:61"));
+    REQUIRE(avapi::toUnixTimestamp("2021-02-19 23:59:60",
+                                   avapi::TimeZone::UTC) == 1613779200);
+    REQUIRE(avapi::toUnixTimestamp("2020-02-29", avapi::TimeZone::UTC) ==
+            1582934400);
+    REQUIRE_THROWS(avapi::toUnixTimestamp("2021-02-29"));
+    REQUIRE_THROWS(avapi::toUnixTimestamp("2020-02-30"));
+    REQUIRE_THROWS(avapi::toUnixTimestamp("2021-02-31"));
+    REQUIRE_THROWS(avapi::toUnixTimestamp("2021-04-31"));
+    REQUIRE_THROWS(avapi::toUnixTimestamp("1900-02-29"));
+}
@@ -0,0 +1,51 @@
+#include "avapi/misc.hpp"
+#include "avapi/CsvStreamParser.hpp"
+#include "catch.hpp"
+
+SCENARIO("avapi::CsvStreamParser")
+{
+    GIVEN("An Alpha Vantage csv response split into uneven chunks.")
+    {
+        std::string csv_string =
+            "timestamp,open,high,low,close,volume\n"
+            "2021-02-19,130.2400,130.7100,128.8000,129.8700,87377537\n"
+            "2021-02-18,129.2000,129.9950,127.4100,129.7100,96856748\n"
+            "2021-02-17,131.2500,132.2200,129.4700,130.8400,97372199";
+
+        WHEN("The chunks are fed one by one.")
+        {
+            avapi::CsvStreamParser parser;
+            for (size_t i = 0; i < csv_string.size(); i += 7) {
+                parser.feed(csv_string.data() + i,
+                            std::min<size_t>(7, csv_string.size() - i));
+            }
+            avapi::TimeSeries series = parser.finish();
+
+            THEN("The time series should match avapi::parseCsvString().")
+            {
+                avapi::TimeSeries expected = avapi::parseCsvString(csv_string);
+                REQUIRE(series.rowCount() == 3);
+                REQUIRE(series.headers == expected.headers);
+                REQUIRE(series[2].timestamp == expected[2].timestamp);
+                REQUIRE(series[2].data == expected[2].data);
+            }
+        }
+    }
+
+    GIVEN("An Alpha Vantage JSON error response.")
+    {
+        std::string json = "{\n    \"Error Message\": \"Invalid API call.\"\n}";
+
+        WHEN("It is fed to the parser.")
+        {
+            avapi::CsvStreamParser parser;
+            parser.feed(json.data(), json.size());
+
+            THEN("finish() should throw.")
+            {
+                REQUIRE(parser.isJson());
+                REQUIRE_THROWS(parser.finish());
+            }
+        }
+    }
+}
@@ -0,0 +1,99 @@
+#include <filesystem>
+#include "avapi/misc.hpp"
+#include "avapi/Transport.hpp"
+#include "avapi/Company/Stock.hpp"
+#include "catch.hpp"
+
+SCENARIO("avapi::FileTransport")
+{
+    GIVEN("A FileTransport serving the captured responses in data/.")
+    {
+        auto transport = std::make_shared<avapi::FileTransport>("data");
+        std::string url = "https://www.alphavantage.co/query?"
+                          "&function=TIME_SERIES_DAILY&symbol=GME"
+                          "&datatype=csv&outputsize=compact&apikey=demo";
+
+        WHEN("A query's key is built.")
+        {
+            THEN("The API key is dropped and the parameters are sorted.")
+            {
+                REQUIRE(avapi::FileTransport::key(url) ==
+                        "datatype=csv&function=TIME_SERIES_DAILY"
+                        "&outputsize=compact&symbol=GME");
+            }
+        }
+
+        WHEN("A query without a mapped file is looked up.")
+        {
+            THEN("Its path is derived from FUNCTION, SYMBOL and datatype.")
+            {
+                REQUIRE(transport->filePath(url) ==
+                        (std::filesystem::path("data") /
+                         "TIME_SERIES_DAILY_GME.csv")
+                            .string());
+            }
+        }
+
+        WHEN("A CompanyStock requests a mapped time series.")
+        {
+            transport->map(url, "daily_GME.csv");
+            avapi::CompanyStock stock("GME", "demo");
+            stock.transport = transport;
+            avapi::TimeSeries series =
+                stock.getTimeSeries(avapi::SeriesType::DAILY, false);
+
+            THEN("The series should match the captured csv file.")
+            {
+                avapi::TimeSeries expected =
+                    avapi::parseCsvFile("data/daily_GME.csv");
+                REQUIRE(series.rowCount() == expected.rowCount());
+                REQUIRE(series[0].timestamp == expected[0].timestamp);
+                REQUIRE(series[0].data == expected[0].data);
+            }
+        }
+
+        WHEN("A series fetched with a projection is refreshed.")
+        {
+            transport->map(url, "daily_GME.csv");
+            avapi::CompanyStock stock("GME", "demo");
+            stock.transport = transport;
+            avapi::TimeSeries series =
+                stock.getTimeSeries(avapi::SeriesType::DAILY, false, "30min",
+                                    avapi::CsvProjection({"close", "volume"}));
+            double close = series.close()[0];
+            stock.refreshTimeSeries(series);
+
+            THEN("The update is parsed into the same columns.")
+            {
+                REQUIRE(series.colCount() == 3);
+                REQUIRE(series.headers[1] == "close");
+                REQUIRE(series.close()[0] == close);
+            }
+        }
+
+        WHEN("The same query is made live and through the FileTransport.")
+        {
+            avapi::CompanyStock live("GME", "demo");
+            live.transport = std::make_shared<avapi::CurlTransport>();
+            avapi::CompanyStock offline("GME", "demo");
+            offline.transport = transport;
+
+            THEN("Their bodies are cached under different keys.")
+            {
+                REQUIRE(live.cacheKey() != offline.cacheKey());
+                REQUIRE(offline.cacheKey().find("#file:data") !=
+                        std::string::npos);
+            }
+        }
+
+        WHEN("A query has no captured response.")
+        {
+            THEN("get() should throw.")
+            {
+                REQUIRE_THROWS(transport->get(
+                    "https://www.alphavantage.co/query?"
+                    "&function=OVERVIEW&symbol=NONE&apikey=demo"));
+            }
+        }
+    }
+}
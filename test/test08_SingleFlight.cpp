@@ -0,0 +1,70 @@
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "avapi/SingleFlight.hpp"
+#include "catch.hpp"
+
+SCENARIO("avapi::SingleFlight")
+{
+    GIVEN("Several threads requesting the same key at once.")
+    {
+        avapi::SingleFlight<std::string> flights;
+        std::atomic<int> calls{0};
+        auto fetch = [&]() {
+            ++calls;
+            return std::string("body");
+        };
+
+        WHEN("They all run while the first fetch is in flight.")
+        {
+            // The leader only lands once every other caller has joined
+            std::vector<std::string> results(4);
+            auto wait = [&]() {
+                while (flights.stats().coalesced < results.size() - 1)
+                    std::this_thread::yield();
+                return fetch();
+            };
+            std::vector<std::thread> threads;
+            for (size_t i = 0; i < results.size(); ++i) {
+                threads.emplace_back(
+                    [&, i]() { results[i] = flights.run("key", wait); });
+            }
+            for (auto &thread : threads)
+                thread.join();
+
+            THEN("Only one fetch is made and every caller gets its result.")
+            {
+                REQUIRE(calls == 1);
+                REQUIRE(flights.stats().fetches == 1);
+                REQUIRE(flights.stats().coalesced == 3);
+                for (auto &result : results)
+                    REQUIRE(result == "body");
+            }
+        }
+
+        WHEN("They run one after another.")
+        {
+            flights.run("key", fetch);
+            flights.run("key", fetch);
+
+            THEN("Each one fetches again.")
+            {
+                REQUIRE(calls == 2);
+                REQUIRE(flights.stats().coalesced == 0);
+            }
+        }
+    }
+
+    GIVEN("A fetch that throws.")
+    {
+        avapi::SingleFlight<std::string> flights;
+
+        THEN("The exception reaches the caller.")
+        {
+            REQUIRE_THROWS(flights.run("key", []() -> std::string {
+                throw std::runtime_error("failed");
+            }));
+        }
+    }
+}
@@ -0,0 +1,88 @@
+#include <stdexcept>
+#include "avapi/misc.hpp"
+#include "avapi/Container/TimeSeries.hpp"
+#include "catch.hpp"
+
+SCENARIO("avapi::TimeSeries::merge()")
+{
+    GIVEN("A cached series and a newer compact download.")
+    {
+        avapi::TimeSeries cached = avapi::parseCsvString(
+            "timestamp,open,high,low,close,volume\n"
+            "2021-02-17,131.2500,132.2200,129.4700,130.8400,97372199\n"
+            "2021-02-16,135.4900,136.0100,132.7900,133.1900,80576316\n"
+            "2021-02-12,134.3500,135.5300,133.6921,135.3700,60145130");
+
+        // 2021-02-17 was revised after the cached download
+        avapi::TimeSeries update = avapi::parseCsvString(
+            "timestamp,open,high,low,close,volume\n"
+            "2021-02-19,130.2400,130.7100,128.8000,129.8700,87377537\n"
+            "2021-02-18,129.2000,129.9950,127.4100,129.7100,96856748\n"
+            "2021-02-17,131.2500,132.2200,129.4700,130.8500,97372199");
+
+        WHEN("The download is merged into the cached series.")
+        {
+            bool merged = cached.merge(update);
+
+            THEN("New bars are added and revised bars replaced, newest first.")
+            {
+                REQUIRE(merged);
+                REQUIRE(cached.rowCount() == 5);
+                REQUIRE(cached[0].timestamp ==
+                        avapi::toUnixTimestamp("2021-02-19"));
+                REQUIRE(cached[2][3] == 130.85);
+                REQUIRE(cached[4].timestamp ==
+                        avapi::toUnixTimestamp("2021-02-12"));
+            }
+        }
+
+        WHEN("The cached series was reversed before merging.")
+        {
+            cached.reverseData();
+            cached.merge(update);
+
+            THEN("The merged series stays oldest first.")
+            {
+                REQUIRE(cached.rowCount() == 5);
+                REQUIRE(cached[0].timestamp ==
+                        avapi::toUnixTimestamp("2021-02-12"));
+                REQUIRE(cached[4].timestamp ==
+                        avapi::toUnixTimestamp("2021-02-19"));
+            }
+        }
+    }
+
+    GIVEN("A download that does not reach back to the cached series.")
+    {
+        avapi::TimeSeries cached = avapi::parseCsvString(
+            "timestamp,open,high,low,close,volume\n"
+            "2021-02-12,134.3500,135.5300,133.6921,135.3700,60145130");
+        avapi::TimeSeries update = avapi::parseCsvString(
+            "timestamp,open,high,low,close,volume\n"
+            "2021-02-19,130.2400,130.7100,128.8000,129.8700,87377537");
+
+        THEN("The merge is refused and the cached series left unchanged.")
+        {
+            REQUIRE_FALSE(cached.merge(update));
+            REQUIRE(cached.rowCount() == 1);
+        }
+    }
+
+    GIVEN("A download parsed with other columns than the cached series.")
+    {
+        std::string csv =
+            "timestamp,open,high,low,close,volume\n"
+            "2021-02-19,130.2400,130.7100,128.8000,129.8700,87377537\n"
+            "2021-02-18,129.2000,129.9950,127.4100,129.7100,96856748";
+        avapi::TimeSeries cached = avapi::parseCsvString(
+            csv, avapi::CsvProjection({"close", "volume"}));
+        avapi::TimeSeries update = avapi::parseCsvString(csv);
+
+        THEN("The merge throws and the cached series is left unchanged.")
+        {
+            REQUIRE_THROWS_AS(cached.merge(update), std::invalid_argument);
+            REQUIRE(cached.colCount() == 3);
+            REQUIRE(cached[0][0] == 129.87);
+        }
+    }
+}
@@ -0,0 +1,75 @@
+#include <stdexcept>
+#include "avapi/CsvTokenizer.hpp"
+#include "catch.hpp"
+
+SCENARIO("avapi::CsvTokenizer")
+{
+    GIVEN("An Alpha Vantage cryptocurrency csv response.")
+    {
+        std::string csv_string =
+            "timestamp,open (CNY),high (CNY),low (CNY),close (CNY),open (USD),"
+            "high (USD),low (USD),close (USD),volume,market cap (USD)\r\n"
+            "2021-03-05,312951.33784600,312964.98828000,300910.55526000,"
+            "303931.37689600,48374.09000000,48376.20000000,46512.90000000,"
+            "46979.84000000,7214.32816400,7214.32816400\r\n";
+
+        WHEN("It is tokenized.")
+        {
+            avapi::TimeSeries series =
+                avapi::CsvTokenizer(true).parse(csv_string);
+
+            THEN("The redundant USD and market cap columns are dropped.")
+            {
+                REQUIRE(series.rowCount() == 1);
+                REQUIRE(series.headers.size() == 6);
+                REQUIRE(series.headers[5] == "volume");
+                REQUIRE(series[0].data.size() == 5);
+                REQUIRE(series[0][0] == 312951.337846);
+                REQUIRE(series[0][4] == 7214.328164);
+            }
+        }
+    }
+
+    GIVEN("A csv response with a malformed cell.")
+    {
+        std::string csv_string = "timestamp,open,high,low,close,volume\n"
+                                 "2021-02-19,130.2400,x,128.8000,129.8700,1\n";
+
+        THEN("Tokenizing it throws.")
+        {
+            REQUIRE_THROWS_AS(avapi::CsvTokenizer().parse(csv_string),
+                              std::invalid_argument);
+        }
+    }
+
+    GIVEN("A csv response of several megabytes.")
+    {
+        std::string csv_string = "timestamp,open,high,low,close,volume\n";
+        for (int i = 0; csv_string.size() < 4 * 1024 * 1024; ++i) {
+            csv_string += "2021-02-" + std::to_string(10 + i % 18) +
+                          " 15:30:00," + std::to_string(i) +
+                          ",130.71,128.80,129.87,87377537\n";
+        }
+
+        WHEN("It is tokenized in parallel chunks.")
+        {
+            avapi::TimeSeries serial = avapi::CsvTokenizer().parse(csv_string);
+            avapi::TimeSeries parallel =
+                avapi::CsvTokenizer().parseParallel(csv_string, 4);
+
+            THEN("The rows match a serial parse, in the same order.")
+            {
+                REQUIRE(parallel.rowCount() == serial.rowCount());
+                REQUIRE(parallel.headers == serial.headers);
+
+                bool same = true;
+                for (size_t i = 0; i < serial.rowCount(); ++i) {
+                    same = same &&
+                           parallel[i].timestamp == serial[i].timestamp &&
+                           parallel[i].data == serial[i].data;
+                }
+                REQUIRE(same);
+            }
+        }
+    }
+}
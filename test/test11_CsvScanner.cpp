@@ -0,0 +1,77 @@
+#include <string>
+#include <vector>
+#include "avapi/CsvScanner.hpp"
+#include "avapi/CsvTokenizer.hpp"
+#include "catch.hpp"
+
+SCENARIO("avapi::CsvScanner")
+{
+    GIVEN("Csv blocks of every length up to a few SIMD registers.")
+    {
+        std::string row = "2021-03-05,48374.09,48376.20,46512.90,7214.3\r\n";
+        std::string data;
+        while (data.size() < 200)
+            data += row;
+
+        WHEN("They are scanned with every supported instruction set.")
+        {
+            bool same = true;
+            for (size_t size = 0; size <= data.size(); ++size) {
+                std::string_view block(data.data(), size);
+
+                std::vector<uint32_t> expected;
+                for (size_t i = 0; i < size; ++i) {
+                    if (block[i] == ',' || block[i] == '\n')
+                        expected.push_back(static_cast<uint32_t>(i));
+                }
+
+                for (auto level : {avapi::SimdLevel::SCALAR,
+                                   avapi::SimdLevel::SSE2,
+                                   avapi::SimdLevel::AVX2}) {
+                    avapi::CsvScanner scanner(level);
+                    size_t count = scanner.scan(block);
+                    same = same &&
+                           std::vector<uint32_t>(scanner.index(),
+                                                 scanner.index() + count) ==
+                               expected;
+                }
+            }
+
+            THEN("Every level finds exactly the commas and newlines.")
+            {
+                REQUIRE(same);
+            }
+        }
+    }
+
+    GIVEN("A csv response spanning several scanner blocks.")
+    {
+        std::string csv_string = "timestamp,open,high,low,close,volume\n";
+        for (int i = 0; csv_string.size() < 256 * 1024; ++i) {
+            csv_string += "2021-02-" + std::to_string(10 + i % 18) + "," +
+                          std::to_string(i) + ",130.71,128.80,129.87,8737\n";
+        }
+
+        WHEN("It is tokenized with the scalar and the best scanner.")
+        {
+            avapi::CsvTokenizer scalar;
+            scalar.setSimdLevel(avapi::SimdLevel::SCALAR);
+            avapi::TimeSeries expected = scalar.parse(csv_string);
+            avapi::TimeSeries series = avapi::CsvTokenizer().parse(csv_string);
+
+            THEN("Both give the same rows.")
+            {
+                REQUIRE(series.rowCount() == expected.rowCount());
+                bool same = true;
+                for (size_t i = 0; i < series.rowCount(); ++i) {
+                    same = same &&
+                           series[i].timestamp == expected[i].timestamp &&
+                           series[i].data == expected[i].data;
+                }
+                REQUIRE(same);
+                REQUIRE(series[series.rowCount() - 1][0] ==
+                        static_cast<double>(series.rowCount() - 1));
+            }
+        }
+    }
+}
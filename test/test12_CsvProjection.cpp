@@ -0,0 +1,110 @@
+#include <string>
+#include "avapi/CsvProjection.hpp"
+#include "avapi/CsvTokenizer.hpp"
+#include "avapi/misc.hpp"
+#include "avapi/Container/LazyTimeSeries.hpp"
+#include "catch.hpp"
+
+SCENARIO("avapi::CsvProjection")
+{
+    GIVEN("An Alpha Vantage cryptocurrency csv response.")
+    {
+        std::string csv_string =
+            "timestamp,open (CNY),high (CNY),low (CNY),close (CNY),open (USD),"
+            "high (USD),low (USD),close (USD),volume,market cap (USD)\n"
+            "2021-03-05,312951.33784600,312964.98828000,300910.55526000,"
+            "303931.37689600,48374.09000000,48376.20000000,46512.90000000,"
+            "46979.84000000,7214.32816400,7214.32816400\n";
+
+        WHEN("Only the close is projected by name.")
+        {
+            avapi::TimeSeries series = avapi::parseCsvString(
+                csv_string, {"close"}, avapi::TimeZone::UTC);
+
+            THEN("The market currency close is the only value kept.")
+            {
+                REQUIRE(series.headers.size() == 2);
+                REQUIRE(series.headers[1] == "close (CNY)");
+                REQUIRE(series[0].data.size() == 1);
+                REQUIRE(series[0][0] == 303931.376896);
+            }
+        }
+
+        WHEN("The USD close and the volume are projected by index.")
+        {
+            avapi::TimeSeries series =
+                avapi::CsvTokenizer(avapi::CsvProjection({8, 9}))
+                    .parse(csv_string);
+
+            THEN("They are kept in file order.")
+            {
+                REQUIRE(series.headers.size() == 3);
+                REQUIRE(series.headers[1] == "close (USD)");
+                REQUIRE(series[0].data.size() == 2);
+                REQUIRE(series[0][0] == 46979.84);
+                REQUIRE(series[0][1] == 7214.328164);
+            }
+        }
+    }
+
+    GIVEN("A cryptocurrency response without the repeated USD columns.")
+    {
+        std::string csv_string = "timestamp,open,high,low,close,volume\n"
+                                 "2021-03-05,48374.09,48376.2,46512.9,"
+                                 "46979.84,7214.328164\n";
+
+        WHEN("It is parsed with the default crypto projection.")
+        {
+            avapi::TimeSeries series = avapi::parseCsvString(csv_string, true);
+
+            THEN("Every column is kept.")
+            {
+                REQUIRE(series.headers.size() == 6);
+                REQUIRE(series[0].data.size() == 5);
+                REQUIRE(series[0][4] == 7214.328164);
+            }
+        }
+    }
+
+    GIVEN("A projection that leaves out a malformed column.")
+    {
+        std::string csv_string = "timestamp,open,high,low,close,volume\n"
+                                 "2021-02-19,130.2400,x,128.8000,129.8700,1\n";
+
+        THEN("The skipped cell is never converted.")
+        {
+            avapi::TimeSeries series =
+                avapi::parseCsvString(csv_string, {"open", "close"});
+            REQUIRE(series[0].data.size() == 2);
+            REQUIRE(series[0][1] == 129.87);
+        }
+    }
+
+    GIVEN("A single column projected with a braced list.")
+    {
+        std::string csv_string = "timestamp,open,high,low,close,volume\n"
+                                 "2021-02-19,130.2400,130.7100,128.8000,"
+                                 "129.8700,87377537\n";
+
+        THEN("The CsvProjection overloads are picked, not the crypto flag.")
+        {
+            avapi::TimeSeries by_name =
+                avapi::parseCsvString(csv_string, {"close"});
+            REQUIRE(by_name.headers.size() == 2);
+            REQUIRE(by_name[0][0] == 129.87);
+
+            avapi::TimeSeries by_index = avapi::parseCsvString(csv_string, {5});
+            REQUIRE(by_index.headers.size() == 2);
+            REQUIRE(by_index.headers[1] == "volume");
+
+            avapi::LazyTimeSeries lazy(csv_string, {"close"});
+            REQUIRE(lazy.colCount() == 2);
+        }
+
+        THEN("A name and an index that look alike get different keys.")
+        {
+            REQUIRE(avapi::CsvProjection({"1"}).key() !=
+                    avapi::CsvProjection({1}).key());
+        }
+    }
+}
@@ -0,0 +1,131 @@
+#include <stdexcept>
+#include <string>
+#include <nlohmann/json.hpp>
+#include "avapi/JsonSax.hpp"
+#include "catch.hpp"
+
+SCENARIO("avapi JSON SAX parsers")
+{
+    GIVEN("An EARNINGS response.")
+    {
+        std::string data = R"json({
+            "symbol": "TSLA",
+            "annualEarnings": [
+                {"fiscalDateEnding": "2020-12-31", "reportedEPS": "2.22"},
+                {"fiscalDateEnding": "2019-12-31", "reportedEPS": "-0.85"}
+            ],
+            "quarterlyEarnings": [
+                {"fiscalDateEnding": "2020-12-31",
+                 "reportedDate": "2021-01-27", "reportedEPS": "0.8",
+                 "estimatedEPS": "1.03", "surprise": "-0.23",
+                 "surprisePercentage": "-22.3301"}
+            ]
+        })json";
+
+        WHEN("It is parsed.")
+        {
+            avapi::AnnualEarnings annual;
+            avapi::QuarterlyEarnings quarterly;
+            avapi::parseEarnings(data, annual, quarterly);
+
+            THEN("Both histories are filled in one pass.")
+            {
+                REQUIRE(annual.data.size() == 2);
+                REQUIRE(annual[1].fiscal_date_ending == "2019-12-31");
+                REQUIRE(annual[1].reported_eps == "-0.85");
+                REQUIRE(quarterly.data.size() == 1);
+                REQUIRE(quarterly[0].reported_date == "2021-01-27");
+                REQUIRE(quarterly[0].surprise_percentage == "-22.3301");
+            }
+        }
+    }
+
+    GIVEN("An OVERVIEW response.")
+    {
+        std::string data =
+            R"json({"Symbol": "TSLA", "AssetType": "Common Stock", "PERatio":
+            "1048.83", "Symbol": "duplicate"})json";
+
+        THEN("Every top level field is kept, the first one winning.")
+        {
+            std::unordered_map<std::string, std::string> fields;
+            avapi::parseOverview(data, fields);
+            REQUIRE(fields.size() == 3);
+            REQUIRE(fields["Symbol"] == "TSLA");
+            REQUIRE(fields["PERatio"] == "1048.83");
+        }
+    }
+
+    GIVEN("A CRYPTO_RATING response.")
+    {
+        std::string data = R"json({"Crypto Rating (FCAS)": {
+            "1. symbol": "BTC", "2. name": "Bitcoin",
+            "3. fcas rating": "Superb", "4. fcas score": "910",
+            "5. developer score": "856", "6. market maturity score": "888",
+            "7. utility score": "974", "8. last refreshed": "2021-03-05",
+            "9. timezone": "UTC"}})json";
+
+        THEN("The fields and the refresh time are read.")
+        {
+            std::vector<std::string> fields;
+            std::time_t timestamp = 0;
+            avapi::parseHealthIndex(data, fields, timestamp);
+            REQUIRE(fields.size() == 8);
+            REQUIRE(fields[1] == "Bitcoin");
+            REQUIRE(fields[7] == "UTC");
+            REQUIRE(timestamp == 1614902400);
+        }
+    }
+
+    GIVEN("A CURRENCY_EXCHANGE_RATE response.")
+    {
+        std::string data = R"json({"Realtime Currency Exchange Rate": {
+            "1. From_Currency Code": "BTC", "5. Exchange Rate": "48374.09",
+            "6. Last Refreshed": "2021-03-05 12:00:00",
+            "7. Time Zone": "UTC", "8. Bid Price": "48374.08",
+            "9. Ask Price": "48374.10"}})json";
+
+        THEN("The rate, bid and ask are read.")
+        {
+            avapi::ExchangeRate rate =
+                avapi::parseExchangeRate(data, "BTC", "USD");
+            REQUIRE(rate.to_symbol == "USD");
+            REQUIRE(rate.timestamp == 1614945600);
+            REQUIRE(rate[0] == 48374.09);
+            REQUIRE(rate[2] == 48374.10);
+        }
+    }
+
+    GIVEN("An Alpha Vantage notice or a malformed body.")
+    {
+        std::string notice = R"json({"Note": "Thank you for calling!"})json";
+
+        THEN("The nested responses throw.")
+        {
+            std::vector<std::string> fields;
+            std::time_t timestamp = 0;
+            REQUIRE_THROWS_AS(
+                avapi::parseHealthIndex(notice, fields, timestamp),
+                std::runtime_error);
+            REQUIRE_THROWS_AS(
+                avapi::parseExchangeRate("{\"a\": ", "BTC", "USD"),
+                nlohmann::json::exception);
+        }
+
+        THEN("Malformed JSON throws nlohmann's own parse_error.")
+        {
+            std::unordered_map<std::string, std::string> fields;
+            REQUIRE_THROWS_AS(avapi::parseOverview("{\"a\": ", fields),
+                              nlohmann::json::parse_error);
+        }
+
+        THEN("A partial exchange rate names what is missing.")
+        {
+            std::string partial = R"json({"Realtime Currency Exchange Rate":
+                {"5. Exchange Rate": "48374.09"}})json";
+            REQUIRE_THROWS_WITH(
+                avapi::parseExchangeRate(partial, "BTC", "USD"),
+                Catch::Contains("field 6 missing"));
+        }
+    }
+}
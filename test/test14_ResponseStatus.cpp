@@ -0,0 +1,56 @@
+#include <string>
+#include "avapi/misc.hpp"
+#include "avapi/ResponseStatus.hpp"
+#include "catch.hpp"
+
+SCENARIO("avapi::classifyResponse")
+{
+    GIVEN("Alpha Vantage's kinds of responses.")
+    {
+        std::string csv = "timestamp,open,high,low,close,volume\n";
+        std::string quote = "{\"Global Quote\": {\"01. symbol\": \"TSLA\"}}";
+        std::string error =
+            "{\n    \"Error Message\": \"Invalid API call. Please retry.\"\n}";
+        std::string note = "{\"Note\": \"Thank you for using Alpha Vantage! "
+                           "Our standard API call frequency is 5 calls per "
+                           "minute.\"}";
+        std::string limit = "{\"Information\": \"You have reached the rate "
+                            "limit of 25 requests per day.\"}";
+        std::string premium = "{\"Information\": \"This is a premium "
+                              "endpoint.\"}";
+
+        THEN("Each is told apart from its first key.")
+        {
+            REQUIRE(avapi::classifyResponse(csv).ok());
+            REQUIRE_FALSE(avapi::classifyResponse(csv).json);
+            REQUIRE(avapi::classifyResponse(quote).ok());
+            REQUIRE(avapi::classifyResponse(quote).json);
+            REQUIRE(avapi::classifyResponse(" \r\n").error ==
+                    avapi::ApiError::EMPTY);
+            REQUIRE(avapi::classifyResponse("{ }").error ==
+                    avapi::ApiError::EMPTY_OBJECT);
+
+            avapi::ResponseStatus status = avapi::classifyResponse(error);
+            REQUIRE(status.error == avapi::ApiError::INVALID_CALL);
+            REQUIRE(status.message == "Invalid API call. Please retry.");
+            REQUIRE(avapi::classifyResponse(note).error ==
+                    avapi::ApiError::RATE_LIMITED);
+            REQUIRE(avapi::classifyResponse(limit).error ==
+                    avapi::ApiError::RATE_LIMITED);
+            REQUIRE(avapi::classifyResponse(premium).error ==
+                    avapi::ApiError::INFORMATION);
+        }
+
+        THEN("Parsing an error as csv throws its status.")
+        {
+            avapi::ApiError kind = avapi::ApiError::NONE;
+            try {
+                avapi::parseCsvString(note);
+            }
+            catch (const avapi::ResponseError &ex) {
+                kind = ex.status().error;
+            }
+            REQUIRE(kind == avapi::ApiError::RATE_LIMITED);
+        }
+    }
+}
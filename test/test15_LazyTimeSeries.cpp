@@ -0,0 +1,106 @@
+#include <stdexcept>
+#include <string>
+#include "avapi/misc.hpp"
+#include "avapi/ResponseStatus.hpp"
+#include "avapi/Container/LazyTimeSeries.hpp"
+#include "catch.hpp"
+
+SCENARIO("avapi::LazyTimeSeries")
+{
+    GIVEN("A daily csv response.")
+    {
+        std::string data = "timestamp,open,high,low,close,volume\r\n"
+                           "2021-03-05,100.5,110,99,105.25,1000\r\n"
+                           "2021-03-04,98,101,97,100.5,2000\r\n"
+                           "\r\n"
+                           "2021-03-03,97,99,96,98,3000\r\n";
+
+        WHEN("It is wrapped lazily.")
+        {
+            avapi::LazyTimeSeries series(data);
+
+            THEN("Only the header and the line boundaries are known.")
+            {
+                REQUIRE(series.rowCount() == 3);
+                REQUIRE(series.colCount() == 6);
+                REQUIRE(series.headers[4] == "close");
+            }
+
+            THEN("Rows and columns match the eager parser.")
+            {
+                avapi::TimeSeries eager = avapi::parseCsvString(data);
+                REQUIRE(series[1].timestamp == eager[1].timestamp);
+                REQUIRE(series[1].data == eager[1].data);
+                REQUIRE(series.column(3) ==
+                        std::vector<double>{105.25, 100.5, 98});
+                REQUIRE(series.timestamps()[2] == eager[2].timestamp);
+
+                avapi::TimeSeries full = series.materialize();
+                REQUIRE(full.rowCount() == 3);
+                REQUIRE(full[2].data == eager[2].data);
+            }
+
+            THEN("Reads are memoized.")
+            {
+                const avapi::TimePair &first = series[0];
+                REQUIRE(&series[0] == &first);
+                REQUIRE(&series.column(4) == &series.column(4));
+            }
+        }
+
+        WHEN("Only some columns are kept.")
+        {
+            avapi::LazyTimeSeries series(
+                data, avapi::CsvProjection({"close", "volume"}));
+
+            THEN("Column indexes follow the projection.")
+            {
+                REQUIRE(series[0].data == std::vector<double>{105.25, 1000});
+                REQUIRE(series.column(1) ==
+                        std::vector<double>{1000, 2000, 3000});
+                REQUIRE_THROWS_AS(series.column(2), std::out_of_range);
+            }
+        }
+    }
+
+    GIVEN("An error response.")
+    {
+        THEN("It throws its status.")
+        {
+            REQUIRE_THROWS_AS(
+                avapi::LazyTimeSeries("{\"Note\": \"Thank you!\"}"),
+                avapi::ResponseError);
+        }
+    }
+
+    GIVEN("A response with a malformed timestamp in its third row.")
+    {
+        avapi::LazyTimeSeries series("timestamp,close\n"
+                                     "2021-02-19,1\n"
+                                     "2021-02-18,2\n"
+                                     "2021-02-1x,3\n"
+                                     "2021-02-16,4\n");
+
+        THEN("Every timestamps() call throws, none returns partial rows.")
+        {
+            for (int i = 0; i < 3; ++i)
+                REQUIRE_THROWS(series.timestamps());
+        }
+    }
+    GIVEN("A response with malformed cells.")
+    {
+        avapi::LazyTimeSeries series("timestamp,open,close\n"
+                                     "2021-02-19,130.24abc,1\n"
+                                     "2021-02-18,2,1.5.2\n");
+
+        THEN("Cells with trailing characters throw, not their leading number.")
+        {
+            REQUIRE_THROWS_AS(series.column(0), std::invalid_argument);
+            REQUIRE_THROWS_AS(series.column(1), std::invalid_argument);
+            REQUIRE_THROWS_AS(series[0], std::invalid_argument);
+            REQUIRE_THROWS_AS(avapi::parseCsvString("timestamp,close\n"
+                                                    "2021-02-19,130.24abc\n"),
+                              std::invalid_argument);
+        }
+    }
+}
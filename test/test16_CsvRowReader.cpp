@@ -0,0 +1,73 @@
+#include <string>
+#include <vector>
+#include "avapi/misc.hpp"
+#include "avapi/CsvRowReader.hpp"
+#include "catch.hpp"
+
+SCENARIO("avapi::CsvRowReader")
+{
+    GIVEN("A csv file larger than the reader's buffer.")
+    {
+        std::string file_path = "data/btc.csv";
+        avapi::TimeSeries eager = avapi::parseCsvFile(file_path, true);
+
+        WHEN("Its rows are read one at a time.")
+        {
+            avapi::CsvRowReader reader(file_path, true);
+            avapi::TimePair row;
+            size_t count = 0;
+            bool same = true;
+            while (reader.next(row)) {
+                same = same && row.timestamp == eager[count].timestamp &&
+                       row.data == eager[count].data;
+                ++count;
+            }
+
+            THEN("They match the eager parser.")
+            {
+                REQUIRE(reader.headers() == eager.headers);
+                REQUIRE(count == eager.rowCount());
+                REQUIRE(reader.rowsRead() == count);
+                REQUIRE(same);
+            }
+        }
+
+        WHEN("It is reduced through forEach() and iterators.")
+        {
+            double volume = 0;
+            avapi::CsvRowReader reader(file_path,
+                                       avapi::CsvProjection({"volume"}),
+                                       avapi::TimeZone::UTC);
+            size_t count = reader.forEach(
+                [&](const avapi::TimePair &row) { volume += row.data[0]; });
+
+            double expected = 0;
+            for (size_t i = 0; i < eager.rowCount(); ++i)
+                expected += eager[i][4];
+
+            size_t rising = 0;
+            for (const avapi::TimePair &row :
+                 avapi::CsvRowReader("data/daily.csv")) {
+                if (row.data[3] > row.data[0])
+                    ++rising;
+            }
+
+            THEN("Every row is visited once.")
+            {
+                REQUIRE(count == eager.rowCount());
+                REQUIRE(volume == Approx(expected));
+                REQUIRE(rising > 0);
+                REQUIRE(rising < 100);
+            }
+        }
+    }
+
+    GIVEN("A missing file.")
+    {
+        THEN("Opening it throws.")
+        {
+            REQUIRE_THROWS_AS(avapi::CsvRowReader("data/missing.csv"),
+                              std::runtime_error);
+        }
+    }
+}
@@ -0,0 +1,106 @@
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include "avapi/misc.hpp"
+#include "avapi/Container/FixedTimeSeries.hpp"
+#include "catch.hpp"
+
+SCENARIO("avapi::FixedTimeSeries")
+{
+    GIVEN("Decimal cells.")
+    {
+        THEN("They are read as exact ticks.")
+        {
+            using avapi::FixedTimeSeries;
+            REQUIRE(FixedTimeSeries::toTicks("130.2400", 4) == 1302400);
+            REQUIRE(FixedTimeSeries::toTicks("-0.23", 4) == -2300);
+            REQUIRE(FixedTimeSeries::toTicks("362182800", 4) ==
+                    3621828000000);
+            REQUIRE(FixedTimeSeries::toTicks("48374.09000000", 8) ==
+                    4837409000000);
+            REQUIRE(FixedTimeSeries::toTicks("1.23456", 4) == 12345);
+            REQUIRE_THROWS_AS(FixedTimeSeries::toTicks("1e5", 4),
+                              std::invalid_argument);
+            REQUIRE_THROWS_AS(FixedTimeSeries::toTicks("", 4),
+                              std::invalid_argument);
+        }
+
+        THEN("Values beyond 64 bit ticks throw instead of wrapping.")
+        {
+            using avapi::FixedTimeSeries;
+            REQUIRE(FixedTimeSeries::toTicks("92233720368.54775807", 8) ==
+                    std::numeric_limits<int64_t>::max());
+            REQUIRE_THROWS_AS(
+                FixedTimeSeries::toTicks("92233720368.54775808", 8),
+                std::invalid_argument);
+            REQUIRE_THROWS_AS(FixedTimeSeries::toTicks("99999999999999.5", 8),
+                              std::invalid_argument);
+            REQUIRE_THROWS_AS(
+                FixedTimeSeries::toTicks("99999999999999999999", 0),
+                std::invalid_argument);
+        }
+
+        THEN("Ticks are printed with every decimal.")
+        {
+            avapi::FixedTimeSeries series(4);
+            REQUIRE(series.toString(1302400) == "130.2400");
+            REQUIRE(series.toString(-2300) == "-0.2300");
+            REQUIRE(series.toString(7) == "0.0007");
+        }
+    }
+
+    GIVEN("An Alpha Vantage csv file.")
+    {
+        std::string file_path = "data/weekly_AAPL.csv";
+        avapi::TimeSeries series = avapi::parseCsvFile(file_path);
+
+        WHEN("It is parsed into ticks.")
+        {
+            avapi::FixedTimeSeries fixed = avapi::parseCsvFileFixed(file_path);
+
+            THEN("Every value matches the double parser.")
+            {
+                REQUIRE(fixed.headers == series.headers);
+                REQUIRE(fixed.rowCount() == series.rowCount());
+                REQUIRE(fixed.colCount() == series.colCount());
+                bool same = true;
+                for (size_t row = 0; row < fixed.rowCount(); ++row) {
+                    same = same &&
+                           fixed.timestamp(row) == series[row].timestamp;
+                    for (size_t col = 0; col + 1 < fixed.colCount(); ++col)
+                        same = same &&
+                               fixed.value(row, col) == series[row][col];
+                }
+                REQUIRE(same);
+                REQUIRE(fixed.toString(fixed.ticks(0, 3)) == "129.8700");
+            }
+
+            THEN("Sums are exact.")
+            {
+                int64_t closes = 0;
+                for (size_t row = 0; row < fixed.rowCount(); ++row)
+                    closes += fixed.ticks(row, 3);
+                REQUIRE(fixed.sum(3) == closes);
+                REQUIRE(fixed.min(3) <= fixed.max(3));
+                REQUIRE(fixed.toTimeSeries()[0].data == series[0].data);
+            }
+        }
+
+        WHEN("A cryptocurrency file is parsed into ticks.")
+        {
+            avapi::FixedTimeSeries btc =
+                avapi::parseCsvFileFixed("data/btc.csv", true);
+
+            THEN("It keeps 8 decimals.")
+            {
+                REQUIRE(btc.decimals() == 8);
+                REQUIRE(btc.colCount() == 6);
+                REQUIRE(btc.ticks(0, 0) == 31295133784600);
+                std::ostringstream os;
+                os << btc;
+                REQUIRE(os.str().find("7214.32816400") != std::string::npos);
+            }
+        }
+    }
+}
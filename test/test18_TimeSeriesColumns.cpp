@@ -0,0 +1,93 @@
+#include <cmath>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "avapi/misc.hpp"
+#include "catch.hpp"
+
+SCENARIO("avapi::TimeSeries columns")
+{
+    GIVEN("A parsed csv file.")
+    {
+        avapi::TimeSeries series = avapi::parseCsvFile("data/weekly_AAPL.csv");
+
+        THEN("Columns are contiguous and match the rows.")
+        {
+            avapi::Span<double> closes = series.close();
+            REQUIRE(closes.size() == series.rowCount());
+            REQUIRE(closes.data() + 1 == &closes[1]);
+            REQUIRE(closes[0] == 129.87);
+            REQUIRE(series.volume()[0] == 362182800);
+            REQUIRE(series.timestamps()[5] == series[5].timestamp);
+            REQUIRE(&series.column(3)[2] == &series[2][3]);
+            REQUIRE_THROWS_AS(series.column("adj_close"), std::out_of_range);
+        }
+
+        THEN("Rows are views that convert to TimePair.")
+        {
+            series[0][3] = 130.0;
+            REQUIRE(series.close()[0] == 130.0);
+
+            avapi::TimePair pair = series[1];
+            REQUIRE(pair.data == series[1].data);
+            REQUIRE(pair.data.size() == 5);
+        }
+
+        THEN("A row's values can be walked with range-for.")
+        {
+            double sum = 0;
+            for (double &value : series[0].data) {
+                sum += value;
+                value = 0;
+            }
+            REQUIRE(sum == 135.49 + 136.01 + 127.41 + 129.87 + 362182800);
+            REQUIRE(series.volume()[0] == 0);
+        }
+
+        THEN("Iterators outlive the row they came from.")
+        {
+            avapi::TimeSeries::Values::iterator first =
+                series[1].data.begin();
+            avapi::TimeSeries::Values::iterator last = series[1].data.end();
+            REQUIRE(*first == series.open()[1]);
+            *first = 1.0;
+            REQUIRE(series.open()[1] == 1.0);
+            REQUIRE(std::distance(first, last) == 5);
+            REQUIRE(first != series[2].data.begin());
+            REQUIRE(first == series[1].data.begin());
+        }
+
+        WHEN("Rows are appended.")
+        {
+            avapi::TimeSeries copy;
+            copy.append(series);
+            copy.pushBack(avapi::TimePair(1, {1, 2, 3}));
+
+            THEN("Short rows are padded with NaN.")
+            {
+                REQUIRE(copy.rowCount() == series.rowCount() + 1);
+                REQUIRE(copy[0].data == series[0].data);
+                size_t last = copy.rowCount() - 1;
+                REQUIRE(copy[last][2] == 3);
+                REQUIRE(std::isnan(copy.close()[last]));
+            }
+        }
+    }
+
+    GIVEN("A csv body with ragged rows.")
+    {
+        avapi::TimeSeries series =
+            avapi::parseCsvString("timestamp,open,close\n"
+                                  "2021-02-19,1.5,2.5,3.5\n"
+                                  "2021-02-12,4.5\n");
+
+        THEN("Long rows are cut to the header, short rows get NaN.")
+        {
+            REQUIRE(series.rowCount() == 2);
+            REQUIRE(series[0].data == std::vector<double>{1.5, 2.5});
+            REQUIRE(series[1][0] == 4.5);
+            REQUIRE(std::isnan(series[1][1]));
+        }
+    }
+}
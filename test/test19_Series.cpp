@@ -0,0 +1,73 @@
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include "avapi/misc.hpp"
+#include "avapi/Container/Series.hpp"
+#include "catch.hpp"
+
+SCENARIO("avapi::Series")
+{
+    GIVEN("A weekly csv file.")
+    {
+        std::string file_path = "data/weekly_AAPL.csv";
+        auto series = avapi::parseCsvFile<avapi::OHLCV>(file_path);
+        avapi::TimeSeries expected = avapi::parseCsvFile(file_path);
+
+        THEN("Rows are read into fixed fields, volume as an integer.")
+        {
+            static_assert(std::is_same<decltype(series[0].volume),
+                                       int64_t>::value,
+                          "OHLCV volume is an integer");
+            REQUIRE(series.rowCount() == expected.rowCount());
+            REQUIRE(series[0].timestamp == expected[0].timestamp);
+            REQUIRE(series[0].close == 129.87);
+            REQUIRE(series[0].volume == 362182800);
+            REQUIRE(series.get<avapi::OHLCV::HIGH>(1) == expected[1][1]);
+            REQUIRE(series.toTimeSeries()[5].data == expected[5].data);
+            REQUIRE(series.toTimeSeries().headers == expected.headers);
+        }
+
+        THEN("A layout the file lacks throws.")
+        {
+            REQUIRE_THROWS_AS(
+                avapi::parseCsvFile<avapi::AdjustedDaily>(file_path),
+                std::invalid_argument);
+        }
+    }
+
+    GIVEN("An adjusted daily and a cryptocurrency response.")
+    {
+        std::string adjusted =
+            "timestamp,open,high,low,close,adjusted_close,volume,"
+            "dividend_amount,split_coefficient\n"
+            "2020-08-31,127.58,131.00,126.00,129.04,128.08,225702688,0.0000,"
+            "4.0\n";
+
+        THEN("Each Schema reads its own columns.")
+        {
+            auto daily = avapi::parseCsvString<avapi::AdjustedDaily>(adjusted);
+            REQUIRE(daily.rowCount() == 1);
+            REQUIRE(daily[0].adj_close == 128.08);
+            REQUIRE(daily[0].volume == 225702688);
+            REQUIRE(daily[0].split_coeff == 4.0);
+
+            auto btc = avapi::parseCsvFile<avapi::CryptoOHLCV>("data/btc.csv");
+            REQUIRE(btc[0].close == 303931.376896);
+            REQUIRE(btc[0].volume == 7214.328164);
+            REQUIRE(btc[0].timestamp == 1614902400);
+        }
+
+        THEN("A volume beyond int64_t throws instead of reading as 0.")
+        {
+            std::string overflow = "timestamp,open,high,low,close,volume\n"
+                                   "2021-02-19,1,2,0.5,1.5,"
+                                   "99999999999999999999\n";
+            REQUIRE_THROWS_AS(avapi::parseCsvString<avapi::OHLCV>(overflow),
+                              std::invalid_argument);
+            REQUIRE_THROWS_AS(avapi::parseCsvString<avapi::OHLCV>(
+                                  "timestamp,open,high,low,close,volume\n"
+                                  "2021-02-19,1,2,0.5,1.5,100x\n"),
+                              std::invalid_argument);
+        }
+    }
+}
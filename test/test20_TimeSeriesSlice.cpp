@@ -0,0 +1,55 @@
+#include <string>
+#include "avapi/misc.hpp"
+#include "catch.hpp"
+
+SCENARIO("avapi::TimeSeries time ranges")
+{
+    GIVEN("A daily series, newest row first.")
+    {
+        avapi::TimeSeries series = avapi::parseCsvFile("data/daily.csv");
+        std::time_t from = avapi::toUnixTimestamp("2021-02-01");
+        std::time_t to = avapi::toUnixTimestamp("2021-02-05");
+
+        THEN("Slices share the series' storage.")
+        {
+            avapi::TimeSeries::View week = series.slice(from, to);
+            REQUIRE(week.rowCount() == 5);
+            REQUIRE(week.timestamps()[0] == to);
+            REQUIRE(week.timestamps()[4] == from);
+            REQUIRE(week.close().data() == &series.close()[week.offset()]);
+            REQUIRE(week[0].timestamp == to);
+
+            REQUIRE(series.lowerBound(from) == week.offset() + 4);
+            REQUIRE(series.lowerBound(series[0].timestamp + 1) ==
+                    series.rowCount());
+            REQUIRE(series.slice(to, from).empty());
+
+            avapi::TimeSeries::View newest = series.last(3);
+            REQUIRE(newest.rowCount() == 3);
+            REQUIRE(newest[0].timestamp == series[0].timestamp);
+        }
+
+        WHEN("The series is reversed.")
+        {
+            avapi::TimeSeries reversed = series;
+            reversed.reverseData();
+
+            THEN("The same rows are found, oldest first.")
+            {
+                avapi::TimeSeries::View week = reversed.slice(from, to);
+                REQUIRE(week.rowCount() == 5);
+                REQUIRE(week.timestamps()[0] == from);
+                REQUIRE(week.timestamps()[4] == to);
+                REQUIRE(reversed[reversed.lowerBound(from)].timestamp == from);
+
+                avapi::TimeSeries::View newest = reversed.last(3);
+                REQUIRE(newest[2].timestamp == series[0].timestamp);
+
+                avapi::TimeSeries copy = week.toTimeSeries();
+                REQUIRE(copy.rowCount() == 5);
+                REQUIRE(copy.headers == series.headers);
+                REQUIRE(copy[4].data == series.slice(from, to)[0].data);
+            }
+        }
+    }
+}
@@ -0,0 +1,56 @@
+#include <ctime>
+#include <type_traits>
+#include <utility>
+#include "avapi/misc.hpp"
+#include "catch.hpp"
+
+SCENARIO("avapi::TimeSeries moves")
+{
+    GIVEN("TimePair and TimeSeries.")
+    {
+        THEN("Both are nothrow move constructible.")
+        {
+            REQUIRE(std::is_nothrow_move_constructible<avapi::TimePair>::value);
+            REQUIRE(
+                std::is_nothrow_move_constructible<avapi::TimeSeries>::value);
+            // Moving into a series on another memory resource copies
+            REQUIRE(std::is_move_assignable<avapi::TimeSeries>::value);
+        }
+    }
+
+    GIVEN("A TimeSeries built with emplaceBack().")
+    {
+        avapi::TimeSeries series;
+        series.reserve(3);
+        size_t capacity = series.capacity();
+        series.emplaceBack(3, 1.0, 2.0, 0.5, 1.5, 100);
+        const std::time_t *timestamps = series.timestamps().data();
+        const double *volumes = series.column(4).data();
+        series.emplaceBack(2, 1.5, 2.5, 1.0, 2.0, 200);
+        series.pushBack(avapi::TimePair(1, {2.0, 3.0, 1.5, 2.5, 300}));
+
+        THEN("Rows land in their columns without growing them.")
+        {
+            REQUIRE(capacity >= 3);
+            REQUIRE(series.capacity() == capacity);
+            REQUIRE(series.timestamps().data() == timestamps);
+            REQUIRE(series.column(4).data() == volumes);
+            REQUIRE(series.rowCount() == 3);
+            REQUIRE(series.colCount() == 6);
+            REQUIRE(series[1][3] == 2.0);
+            REQUIRE(series.column(4)[2] == 300);
+        }
+
+        WHEN("It is moved.")
+        {
+            const double *closes = series.column(3).data();
+            avapi::TimeSeries moved = std::move(series);
+
+            THEN("The columns are handed over, not copied.")
+            {
+                REQUIRE(moved.rowCount() == 3);
+                REQUIRE(moved.column(3).data() == closes);
+            }
+        }
+    }
+}
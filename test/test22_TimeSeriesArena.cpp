@@ -0,0 +1,64 @@
+#include <memory_resource>
+#include <string>
+#include <utility>
+#include "avapi/misc.hpp"
+#include "catch.hpp"
+
+SCENARIO("avapi::TimeSeries on a memory resource")
+{
+    GIVEN("A csv body and a monotonic arena.")
+    {
+        std::string data = "timestamp,open,high,low,close,volume\n"
+                           "2021-02-19,135.49,136.01,127.41,129.87,362182800\n"
+                           "2021-02-12,136.03,137.42,133.59,135.37,284817325\n";
+        std::pmr::monotonic_buffer_resource arena;
+
+        WHEN("It is parsed into the arena.")
+        {
+            avapi::TimeSeries series = avapi::parseCsvString(data, &arena);
+
+            THEN("Its columns are drawn from the arena.")
+            {
+                REQUIRE(series.resource() == &arena);
+                REQUIRE(series.rowCount() == 2);
+                REQUIRE(series.close()[1] == 135.37);
+                REQUIRE(series.headers.size() == 6);
+            }
+
+            THEN("Appends, slices and moves stay in the arena.")
+            {
+                series.emplaceBack(1612483200, 1.0, 2.0, 0.5, 1.5, 100);
+                REQUIRE(series.rowCount() == 3);
+                REQUIRE(series.rows(0, 2).toTimeSeries().resource() == &arena);
+                avapi::TimeSeries moved = std::move(series);
+                REQUIRE(moved.resource() == &arena);
+            }
+
+            THEN("Copies go to the heap unless a resource is given.")
+            {
+                avapi::TimeSeries heap = series;
+                REQUIRE(heap.resource() == std::pmr::get_default_resource());
+                avapi::TimeSeries copy(heap, &arena);
+                REQUIRE(copy.resource() == &arena);
+                REQUIRE(copy.close()[0] == 129.87);
+            }
+
+            THEN("Assigning keeps the target's resource.")
+            {
+                avapi::TimeSeries heap;
+                heap = std::move(series);
+                REQUIRE(heap.resource() == std::pmr::get_default_resource());
+                REQUIRE(heap.rowCount() == 2);
+                REQUIRE(heap.open()[0] == 135.49);
+            }
+        }
+
+        THEN("Crypto bodies are parsed into the arena too.")
+        {
+            avapi::TimeSeries series =
+                avapi::parseCsvFile("data/btc.csv", &arena, true);
+            REQUIRE(series.resource() == &arena);
+            REQUIRE(series.rowCount() == 1000);
+        }
+    }
+}
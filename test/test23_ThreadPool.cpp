@@ -0,0 +1,39 @@
+#include <future>
+#include <mutex>
+#include <vector>
+#include "avapi/ThreadPool.hpp"
+#include "catch.hpp"
+
+SCENARIO("avapi::ThreadPool")
+{
+    GIVEN("A single worker kept busy while tasks are queued.")
+    {
+        avapi::ThreadPool pool(1);
+        std::promise<void> release;
+        std::shared_future<void> released = release.get_future().share();
+        pool.submit([released]() { released.wait(); });
+
+        std::mutex mutex;
+        std::vector<int> order;
+        auto record = [&](int task) {
+            return [&, task]() {
+                std::lock_guard<std::mutex> lock(mutex);
+                order.push_back(task);
+            };
+        };
+
+        std::vector<std::future<void>> done;
+        done.push_back(pool.submit(record(0), avapi::Priority::BACKFILL));
+        done.push_back(pool.submit(record(1), avapi::Priority::NORMAL));
+        done.push_back(pool.submit(record(2), avapi::Priority::BACKFILL));
+        done.push_back(pool.submit(record(3), avapi::Priority::LIVE));
+        release.set_value();
+        for (auto &task : done)
+            task.get();
+
+        THEN("They run by priority, then in the order they were queued.")
+        {
+            REQUIRE(order == std::vector<int>{3, 1, 0, 2});
+        }
+    }
+}